@@ -29,6 +29,8 @@ using namespace eosio;
 static constexpr uint64_t  DAY_SECONDS = 24 * 60 * 60;
 static constexpr uint64_t  YEAR_SECONDS = 365 * 24 * 60 * 60;
 static constexpr uint64_t  YEAR_DAYS   = 365;
+static constexpr uint32_t  MAX_STATS_FILL_DAYS = 31;      //max dailystats rows written for an idle gap
+static constexpr uint64_t  BATCH_SAVE_ID = UINT64_MAX;     //intcolllog account_id of logs summed over positions
 
 namespace plan_type {
     static constexpr eosio::name TERM       = "term"_n;
@@ -53,8 +55,20 @@ GLOBAL_TBL("global") global_t {
 
 typedef eosio::singleton< "global"_n, global_t > global_singleton;
 
+//farm lease availability, refreshed at most once per block
+GLOBAL_TBL("farmcache") farm_cache_t {
+    asset           available_apples        = asset(0, symbol("APL", 4));   //farm available minus pending
+    asset           pending_apples          = asset(0, symbol("APL", 4));   //accumulated, not yet alloted
+    time_point      refreshed_at;                                           //block time of last farm read
+
+    EOSLIB_SERIALIZE( farm_cache_t, (available_apples)(pending_apples)(refreshed_at) )
+};
+
+typedef eosio::singleton< "farmcache"_n, farm_cache_t > farm_cache_singleton;
+
 
 //scope: self
+//Note: legacy row, split into plan_conf_t and plan_state_t by migrateplan
 SAVE_TBL save_plan_t {
     uint64_t                          id;                             //PK
     string                            plan_name;                
@@ -79,9 +93,6 @@ SAVE_TBL save_plan_t {
 
     uint64_t primary_key()const { return id; }
     uint64_t scope()const { return 0; }
-    
-    uint32_t calc_available_quotas()  const { return total_quotas   - quotas_purchased; }
-    asset    calc_available_interest()const { return interest_total - interest_collected; }
 
     typedef multi_index<"saveplan"_n, save_plan_t > tbl_t;
 
@@ -96,9 +107,100 @@ SAVE_TBL save_plan_t {
 
 };
 
+//scope: self
+//Note: read-mostly, only written by admin actions
+SAVE_TBL plan_conf_t {
+    uint64_t                          id;                             //PK
+    string                            plan_name;                
+    extended_symbol                   interest_symbol;                //interest token symbol
+    extended_symbol                   stake_symbol;                   //stake token symbol
+    extended_symbol                   lquidity_extsym;      
+    uint16_t                          plan_days;                      //plan days
+    asset                             plan_profit;                    //plan profit per quota
+    uint32_t                          total_quotas;                   //total quotas
+    asset                             stake_per_quota;                //stake amount per quota
+    asset                             apl_per_quota;                  //apl reward per quota
+    name                              type    = plan_type::TERM;      //plan type
+    time_point_sec                    begin_at;             
+    time_point_sec                    end_at;               
+    time_point_sec                    created_at;    
+    plan_conf_t() {}
+    plan_conf_t(const uint64_t& i): id(i) {}
+
+    uint64_t primary_key()const { return id; }
+    uint64_t scope()const { return 0; }
+
+    typedef multi_index<"planconf"_n, plan_conf_t > tbl_t;
+
+    EOSLIB_SERIALIZE( plan_conf_t,  (id)(plan_name)                    
+                                    (interest_symbol)(stake_symbol)
+                                    (lquidity_extsym)(plan_days)
+                                    (plan_profit)(total_quotas)
+                                    (stake_per_quota)(apl_per_quota)
+                                    (type)(begin_at)(end_at)(created_at) )
+
+};
+
+//scope: self
+//Note: fixed-size mutable counters, pledged amounts are in the plan's stake symbol,
+//      interest amounts in the plan's interest symbol
+SAVE_TBL plan_state_t {
+    uint64_t                          id;                             //PK, same as plan_conf_t
+    uint32_t                          quotas_purchased   = 0;
+    int64_t                           interest_total     = 0;         //prestore total interest
+    int64_t                           interest_collected = 0;
+    name                              status  = plan_status::RUNNING; //plan status
+    int64_t                           pledged_total      = 0;         //principal of active positions
+    int64_t                           interest_alloted   = 0;         //interest alloted to active positions
+    uint32_t                          active_positions   = 0;
+    uint32_t                          stats_day          = 0;         //UTC day of the counters below
+    int64_t                           day_pledged        = 0;         //principal pledged on stats_day
+
+    plan_state_t() {}
+    plan_state_t(const uint64_t& i): id(i) {}
+
+    uint64_t primary_key()const { return id; }
+    uint64_t scope()const { return 0; }
+    
+    uint32_t calc_available_quotas(const plan_conf_t& conf)const { return conf.total_quotas - quotas_purchased; }
+    int64_t  calc_available_interest()const { return interest_total - interest_collected; }
+
+    typedef multi_index<"planstate"_n, plan_state_t > tbl_t;
+
+    EOSLIB_SERIALIZE( plan_state_t, (id)(quotas_purchased)(interest_total)(interest_collected)(status)
+                                    (pledged_total)(interest_alloted)(active_positions)
+                                    (stats_day)(day_pledged) )
+
+};
+
+//scope: plan_id
+//Note: written by the first action touching the plan on the next UTC day, idle days get
+//      a row with unchanged closing values and zero inflow; beyond MAX_STATS_FILL_DAYS a
+//      missing day means the same as the last row before it.
+//      Totals only cover positions already converted from saveaccounts.
+SAVE_TBL daily_stats_t {
+    uint32_t                          day;                            //PK, UTC days since epoch
+    int64_t                           pledged_total      = 0;         //closing values of the day
+    int64_t                           interest_alloted   = 0;
+    int64_t                           interest_collected = 0;
+    uint32_t                          active_positions   = 0;
+    int64_t                           day_pledged        = 0;         //inflow of the day
+
+    daily_stats_t() {}
+    daily_stats_t(const uint32_t& d): day(d) {}
+
+    uint64_t primary_key()const { return day; }
+
+    typedef multi_index<"dailystats"_n, daily_stats_t > tbl_t;
+
+    EOSLIB_SERIALIZE( daily_stats_t,    (day)(pledged_total)(interest_alloted)(interest_collected)
+                                        (active_positions)(day_pledged) )
+
+};
+
 //Scope: account
-//Note: record will be deleted upon withdrawal/redemption
-SAVE_TBL save_account_t {
+//Note: legacy row, converted into save_account_t by migrate or upon first touch
+SAVE_TBL save_account_v1_t {
     uint64_t            id;                   //PK
     uint64_t            plan_id;
     asset               pledged;              //amount
@@ -111,33 +213,137 @@ SAVE_TBL save_account_t {
     time_point_sec      last_collected_at;
     time_point_sec      created_at;
 
+    save_account_v1_t() {}
+    save_account_v1_t(const uint64_t& i): id(i) {}
+
+    uint64_t primary_key()const { return id; }
+
+    typedef multi_index<"saveaccounts"_n, save_account_v1_t> tbl_t;
+
+    EOSLIB_SERIALIZE( save_account_v1_t,    (id)(plan_id)(pledged)
+                                            (lquidity_extsym)(quotas)
+                                            (plan_term_days)(interest_alloted)
+                                            (interest_collected)(term_ended_at)
+                                            (last_collected_at)(created_at) )
+
+};
+
+//Scope: account
+//Note: record will be deleted upon withdrawal/redemption
+//      symbols come from the plan: pledged in stake_symbol, interest in interest_symbol
+SAVE_TBL save_account_t {
+    uint64_t            id;                   //PK
+    uint64_t            plan_id;
+    int64_t             pledged          = 0; //stake amount
+    uint32_t            quotas           = 0;
+    int64_t             interest_alloted = 0; //alloted interest amount
+    int64_t             interest_collected = 0;
+    time_point_sec      created_at;           //base timestamp
+    uint16_t            term_days        = 0; //term_ended_at    = created_at + term_days
+    uint32_t            collected_secs   = 0; //last_collected_at = created_at + collected_secs
+
     save_account_t() {}
     save_account_t(const uint64_t& i): id(i) {}
 
+    save_account_t(const save_account_v1_t& v1): id(v1.id) {
+        plan_id             = v1.plan_id;
+        pledged             = v1.pledged.amount;
+        quotas              = v1.quotas;
+        interest_alloted    = v1.interest_alloted.amount;
+        interest_collected  = v1.interest_collected.amount;
+        created_at          = v1.created_at;
+        term_days           = v1.plan_term_days;
+        set_last_collected_at( v1.last_collected_at );
+    }
+
     uint64_t primary_key()const { return id; }
 
+    time_point_sec term_ended_at()const     { return created_at + term_days * DAY_SECONDS; }
+    time_point_sec last_collected_at()const { return created_at + collected_secs; }
+
+    void set_last_collected_at(const time_point_sec& t) {
+      ASSERT( t >= created_at )
+      collected_secs = t.sec_since_epoch() - created_at.sec_since_epoch();
+    }
+
     // Interest Calculate Formula: (current - created_at)/(term_ended_at - created_at) * total_interest - interest_collected
-    asset calc_due_interest()const { 
+    int64_t calc_due_interest()const { 
       uint32_t now                  = time_point_sec(current_time_point()).sec_since_epoch();
       uint32_t created_timestamp    = created_at.sec_since_epoch();
-      uint32_t term_ended_timestamp = term_ended_at.sec_since_epoch();
+      uint32_t term_ended_timestamp = term_ended_at().sec_since_epoch();
       uint32_t collect_timestamp = now > term_ended_timestamp ? term_ended_timestamp : now;
       ASSERT( (collect_timestamp - created_timestamp) >= 0 )
       ASSERT( (term_ended_timestamp - created_timestamp) > 0 )
 
       double ratio = double(collect_timestamp - created_timestamp) / double(term_ended_timestamp - created_timestamp);
-      int64_t interest = ratio * interest_alloted.amount - interest_collected.amount;
-      return asset(interest, interest_alloted.symbol); 
+      return ratio * interest_alloted - interest_collected;
     }
 
-    typedef multi_index<"saveaccounts"_n, save_account_t> tbl_t;
+    typedef multi_index<"saveaccts"_n, save_account_t> tbl_t;
+
+    EOSLIB_SERIALIZE( save_account_t,   (id)(plan_id)(pledged)(quotas)
+                                        (interest_alloted)(interest_collected)
+                                        (created_at)(term_days)(collected_secs) )
+
+};
+
+//scope: self
+//Note: one row per save account, deleted upon redemption
+SAVE_TBL save_index_t {
+    uint64_t            save_id;              //PK, same as save_account_t
+    name                owner;                //scope of the save account
+    uint64_t            plan_id;
+    time_point_sec      term_ended_at;
+
+    save_index_t() {}
+    save_index_t(const uint64_t& i): save_id(i) {}
+
+    uint64_t primary_key()const { return save_id; }
+    uint64_t scope()const { return 0; }
+
+    checksum256 by_plan_term()const { return make256key(plan_id, term_ended_at.sec_since_epoch(), save_id, 0); }
+
+    typedef multi_index<"saveindex"_n, save_index_t,
+        indexed_by<"planterm"_n, const_mem_fun<save_index_t, checksum256, &save_index_t::by_plan_term> >
+    > tbl_t;
+
+    EOSLIB_SERIALIZE( save_index_t, (save_id)(owner)(plan_id)(term_ended_at) )
+};
+
+//scope: self
+SAVE_TBL plan_crank_t {
+    uint64_t            plan_id;              //PK
+    uint64_t            next_cursor  = 0;     //next save id + 1 to resume crank from, 0: pass finished
+    time_point_sec      cranked_at;
+
+    plan_crank_t() {}
+    plan_crank_t(const uint64_t& i): plan_id(i) {}
+
+    uint64_t primary_key()const { return plan_id; }
+    uint64_t scope()const { return 0; }
+
+    typedef multi_index<"plancrank"_n, plan_crank_t> tbl_t;
+
+    EOSLIB_SERIALIZE( plan_crank_t, (plan_id)(next_cursor)(cranked_at) )
+};
+
+//scope: self
+//Note: record will be deleted once alloted by flushapl, the pledger's creator is resolved there
+SAVE_TBL apl_pending_t {
+    name                pledger;              //PK
+    asset               apples;               //pending apl to allot
+    uint64_t            last_save_id = 0;     //latest save account credited
+    time_point_sec      updated_at;
+
+    apl_pending_t() {}
+    apl_pending_t(const name& p): pledger(p) {}
+
+    uint64_t primary_key()const { return pledger.value; }
+    uint64_t scope()const { return 0; }
 
-    EOSLIB_SERIALIZE( save_account_t,   (id)(plan_id)(pledged)
-                                        (lquidity_extsym)(quotas)
-                                        (plan_term_days)(interest_alloted)
-                                        (interest_collected)(term_ended_at)
-                                        (last_collected_at)(created_at) )
+    typedef multi_index<"aplpending"_n, apl_pending_t> tbl_t;
 
+    EOSLIB_SERIALIZE( apl_pending_t, (pledger)(apples)(last_save_id)(updated_at) )
 };
 
 } //namespace amax
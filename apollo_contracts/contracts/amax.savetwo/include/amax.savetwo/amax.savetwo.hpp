@@ -116,6 +116,42 @@ class [[eosio::contract("apollo.save")]] amax_savetwo : public contract {
   ACTION redeem(const name& issuer, const name& owner, const uint64_t& save_id);
   
 
+  /**
+  * @brief collect due interest for all positions of a plan, then redeem matured ones
+  *
+  * @param plan_id  plan id.
+  * @param cursor  save id + 1 to resume from, 0 to start from the earliest term end;
+  *                the next cursor is recorded in plancrank, 0 once the pass is finished.
+  *                Interest and principal are transferred once per owner, logged with
+  *                account_id BATCH_SAVE_ID.
+  * @param max_rows  max positions to process in this action.
+  */
+  ACTION crank(const uint64_t& plan_id, const uint64_t& cursor, const uint32_t& max_rows);
+
+  /**
+  * @brief convert legacy save accounts of an owner into compact rows
+  *
+  * @param owner  scope of the save accounts.
+  * @param cursor  save id to resume from.
+  * @param max_rows  max rows to convert in this action.
+  */
+  ACTION migrate(const name& owner, const uint64_t& cursor, const uint32_t& max_rows);
+
+  /**
+  * @brief split a legacy plan row into planconf and planstate,
+  *        legacy plans are also converted upon first touch
+  *
+  * @param plan_id  plan id.
+  */
+  ACTION migrateplan(const uint64_t& plan_id);
+
+  /**
+  * @brief allot pending apl of pledgers to their parent accounts in batch
+  *
+  * @param max_rows  max pending rows to allot in this action.
+  */
+  ACTION flushapl(const uint32_t& max_rows);
+
   ACTION intcolllog(const name& account, const uint64_t& account_id, const uint64_t& plan_id, const asset &quantity);
   using interest_collect_log_action = eosio::action_wrapper<"intcolllog"_n, &amax_savetwo::intcolllog>; 
   
@@ -136,13 +172,30 @@ class [[eosio::contract("apollo.save")]] amax_savetwo : public contract {
                               const uint32_t &begin_at,
                               const uint32_t &end_at);
 
-      void _create_save_act(save_plan_t &plan,
+      void _create_save_act(const plan_conf_t &plan,
+                            plan_state_t &state,
                             const asset &quantity,
                             const name &from,                                 
                             const uint32_t &quotas,
                             const time_point_sec &now);
                             
+      bool _get_save_acct(const name& owner, save_account_t& save_acct);
+
+      bool _migrate_plan(const uint64_t& plan_id);
+
+      bool _get_plan(plan_conf_t& plan);
+
+      bool _get_plan(plan_state_t& state);
+
+      void _set_save_index(const name& owner, const save_account_t& save_acct);
+
+      void _roll_daily_stats(plan_state_t& state);
+
+      void _add_position(const save_account_t& save_acct);
+
       void _allot_apl(asset apl, const name& from, const uint64_t& sid);  
+
+      void _refresh_farm_cache(farm_cache_t& cache);
                                                                                                      
       void _int_coll_log(const name& account, const uint64_t& account_id, const uint64_t& plan_id, const asset &quantity);
       
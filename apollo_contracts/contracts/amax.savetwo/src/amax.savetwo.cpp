@@ -25,6 +25,11 @@ using namespace wasm::safemath;
   void amax_savetwo::init(const uint64_t &farm_id) {
       require_auth( _self );
       _gstate.farm_lease_id = farm_id;
+
+      farm_cache_singleton farm_cache(_self, _self.value);
+      auto cache = farm_cache.get_or_default();
+      cache.refreshed_at = time_point();   //force a re-read of the new lease
+      farm_cache.set( cache, _self );
   }
 
   void amax_savetwo::createplan(const string &plan_name, 
@@ -70,8 +75,8 @@ using namespace wasm::safemath;
                                 const uint32_t &end_at) {
       require_auth(_gstate.admin);
       
-      save_plan_t plan(plan_id);
-      CHECKC( _db.get( plan ), err::RECORD_NOT_FOUND, "plan not found: " + to_string( plan_id ) )
+      plan_conf_t plan(plan_id);
+      CHECKC( _get_plan( plan ), err::RECORD_NOT_FOUND, "plan not found: " + to_string( plan_id ) )
       
       CHECKC( end_at > plan.begin_at.sec_since_epoch(), err::PARAM_ERROR, "begin time should be less than end time");
       CHECKC( end_at - plan.begin_at.sec_since_epoch() <= (YEAR_SECONDS * 3), err::PARAM_ERROR, "the duration of the plan cannot exceed 3 years");
@@ -94,8 +99,8 @@ using namespace wasm::safemath;
                                 const int64_t &total_quotas) {
       require_auth(_gstate.admin);
       
-      save_plan_t plan(plan_id);
-      CHECKC( _db.get( plan ), err::RECORD_NOT_FOUND, "plan not found: " + to_string( plan_id ) )
+      plan_conf_t plan(plan_id);
+      CHECKC( _get_plan( plan ), err::RECORD_NOT_FOUND, "plan not found: " + to_string( plan_id ) )
       
       CHECKC( plan.end_at > begin_at, err::PARAM_ERROR, "begin time should be less than end time");
       CHECKC( plan.end_at.sec_since_epoch() - begin_at.sec_since_epoch() <= (YEAR_SECONDS * 3), err::PARAM_ERROR, "the duration of the plan cannot exceed 3 years");
@@ -114,8 +119,8 @@ using namespace wasm::safemath;
 
   void amax_savetwo::setstatus(const uint64_t &plan_id, const name &status) {
       require_auth( _gstate.admin );
-      save_plan_t plan(plan_id);
-      CHECKC( _db.get( plan ), err::RECORD_NOT_FOUND, "plan not found: " + to_string( plan_id ) )
+      plan_state_t plan(plan_id);
+      CHECKC( _get_plan( plan ), err::RECORD_NOT_FOUND, "plan not found: " + to_string( plan_id ) )
       CHECKC( status == plan_status::BLOCKED || status == plan_status::RUNNING || status == plan_status::SUSPENDED, err::STATE_MISMATCH, "state mismatch");
       plan.status = status;
       _db.set( plan );
@@ -124,11 +129,12 @@ using namespace wasm::safemath;
   void amax_savetwo::delplan(const uint64_t& plan_id) {
       require_auth( _gstate.admin );
       
-      save_plan_t plan(plan_id);
-      CHECKC( _db.get( plan ), err::RECORD_NOT_FOUND, "plan not found: " + to_string( plan_id ) )
+      plan_conf_t plan(plan_id);
+      CHECKC( _get_plan( plan ), err::RECORD_NOT_FOUND, "plan not found: " + to_string( plan_id ) )
       CHECKC( plan.begin_at > current_time_point(), amaxsavetwo_err::STARTED, "plan already started" )
       
       _db.del( plan );
+      _db.del( plan_state_t(plan_id) );
   }
   
   /**
@@ -152,15 +158,18 @@ using namespace wasm::safemath;
 
       if ( parts.size() == 2 && parts[0] == "refuelint" ) {
           uint64_t plan_id = to_uint64(parts[1], "plan_id parse int error");
-          save_plan_t plan(plan_id);
-          CHECKC( _db.get( plan ), err::RECORD_NOT_FOUND, "plan not found: " + to_string( plan_id ) )   
+          plan_conf_t plan(plan_id);
+          CHECKC( _get_plan( plan ), err::RECORD_NOT_FOUND, "plan not found: " + to_string( plan_id ) )   
+          plan_state_t state(plan_id);
+          CHECKC( _get_plan( state ), err::RECORD_NOT_FOUND, "plan state not found: " + to_string( plan_id ) )
            
           CHECKC( quantity.amount > 0, err::PARAM_ERROR, "token amount invalid" )      
           CHECKC( quantity.symbol == plan.interest_symbol.get_symbol(), err::PARAM_ERROR, "token symbol invalid" )
           CHECKC( get_first_receiver() == plan.interest_symbol.get_contract(), err::PARAM_ERROR, "token contract invalid" )
 
-          plan.interest_total       += quantity;
-          _db.set(plan);
+          _roll_daily_stats(state);
+          state.interest_total      += quantity.amount;
+          _db.set(state);
           
       } else if ( parts.size() == 3 && parts[0] == "pledge" )  {
           auto now  = time_point_sec(current_time_point());
@@ -168,19 +177,21 @@ using namespace wasm::safemath;
           auto plan_id  = to_uint64(parts[1], "plan_id parse int error");
           auto quotas   = to_uint64(parts[2], "quotas parse uint error");
 
-          save_plan_t plan(plan_id);
-          CHECKC( _db.get( plan ), err::RECORD_NOT_FOUND, "plan not found: " + to_string( plan_id ) ) 
-          CHECKC( plan.status == plan_status::RUNNING, err::PAUSED, "temporarily suspended" )
+          plan_state_t state(plan_id);
+          CHECKC( _get_plan( state ), err::RECORD_NOT_FOUND, "plan not found: " + to_string( plan_id ) ) 
+          CHECKC( state.status == plan_status::RUNNING, err::PAUSED, "temporarily suspended" )
+          plan_conf_t plan(plan_id);
+          CHECKC( _get_plan( plan ), err::RECORD_NOT_FOUND, "plan not found: " + to_string( plan_id ) ) 
    
           CHECKC( quantity.amount > 0, err::PARAM_ERROR, "token amount invalid" )      
           CHECKC( quotas > 0 && quantity / quotas >= plan.stake_per_quota, err::PARAM_ERROR, "token amount invalid" )      
           CHECKC( quantity.symbol == plan.stake_symbol.get_symbol(), err::PARAM_ERROR, "token symbol invalid" )
           CHECKC( get_first_receiver() == plan.stake_symbol.get_contract(), err::PARAM_ERROR, "token contract invalid" )
-          CHECKC( plan.calc_available_quotas() > 0 && quotas <= plan.calc_available_quotas(), amaxsavetwo_err::QUOTAS_INSUFFICIENT, "quotas insufficient" )
+          CHECKC( state.calc_available_quotas(plan) > 0 && quotas <= state.calc_available_quotas(plan), amaxsavetwo_err::QUOTAS_INSUFFICIENT, "quotas insufficient" )
           CHECKC( plan.end_at >= now, amaxsavetwo_err::ENDED, "the plan already ended" )
           CHECKC( plan.begin_at <= now, amaxsavetwo_err::NOT_START, "the plan not start" )
 
-          _create_save_act(plan, quantity, from, quotas, now);
+          _create_save_act(plan, state, quantity, from, quotas, now);
           
       } else {
           CHECKC( false, err::PARAM_ERROR, "param error" );
@@ -191,30 +202,33 @@ using namespace wasm::safemath;
       require_auth( issuer );
 
       save_account_t save_acct( save_id );
-      CHECKC( _db.get( owner.value, save_acct ), err::RECORD_NOT_FOUND, "account save not found" )
+      CHECKC( _get_save_acct( owner, save_acct ), err::RECORD_NOT_FOUND, "account save not found" )
 
       auto now = current_time_point();
-      CHECKC( save_acct.last_collected_at < save_acct.term_ended_at, amaxsavetwo_err::INTEREST_COLLECTED, "interest already collected" )
+      CHECKC( save_acct.last_collected_at() < save_acct.term_ended_at(), amaxsavetwo_err::INTEREST_COLLECTED, "interest already collected" )
 
-      auto elapsed_sec = now.sec_since_epoch() - save_acct.last_collected_at.sec_since_epoch();
+      auto elapsed_sec = now.sec_since_epoch() - save_acct.last_collected_at().sec_since_epoch();
  
       CHECKC( elapsed_sec > DAY_SECONDS, amaxsavetwo_err::TIME_PREMATURE, "less than 24 hours since last interest collection time" )
       
-      save_plan_t plan( save_acct.plan_id );
-      CHECKC( _db.get( plan ), err::RECORD_NOT_FOUND, "plan not found: " + to_string( save_acct.plan_id ) )
+      plan_conf_t plan( save_acct.plan_id );
+      CHECKC( _get_plan( plan ), err::RECORD_NOT_FOUND, "plan not found: " + to_string( save_acct.plan_id ) )
+      plan_state_t state( save_acct.plan_id );
+      CHECKC( _get_plan( state ), err::RECORD_NOT_FOUND, "plan state not found: " + to_string( save_acct.plan_id ) )
 
-      auto interest_due = save_acct.calc_due_interest();
+      auto interest_due = asset( save_acct.calc_due_interest(), plan.interest_symbol.get_symbol() );
       CHECKC( interest_due.amount > 0, err::NOT_POSITIVE, "interest due amount is zero" )
-      CHECKC( plan.calc_available_interest() >= interest_due, err::NOT_POSITIVE, "insufficient available interest to collect" )
+      CHECKC( state.calc_available_interest() >= interest_due.amount, err::NOT_POSITIVE, "insufficient available interest to collect" )
       
       TRANSFER( plan.interest_symbol.get_contract(), owner, interest_due, "interest: " + to_string(save_id) )
       
-      save_acct.interest_collected    += interest_due;
-      save_acct.last_collected_at     = now;
+      save_acct.interest_collected    += interest_due.amount;
+      save_acct.set_last_collected_at( now );
       _db.set( owner.value, save_acct );
 
-      plan.interest_collected     += interest_due;
-      _db.set( plan );
+      _roll_daily_stats(state);
+      state.interest_collected    += interest_due.amount;
+      _db.set( state );
 
       _int_coll_log(owner, save_acct.id, plan.id, interest_due);
   }
@@ -227,26 +241,233 @@ using namespace wasm::safemath;
       }
 
       auto save_acct = save_account_t( save_id );
-      CHECKC( _db.get( owner.value, save_acct ), err::RECORD_NOT_FOUND, "account save not found" )
+      CHECKC( _get_save_acct( owner, save_acct ), err::RECORD_NOT_FOUND, "account save not found" )
 
-      auto plan = save_plan_t( save_acct.plan_id );
-      CHECKC( _db.get( plan ), err::RECORD_NOT_FOUND, "plan not found: " + to_string(save_acct.plan_id) )
-      CHECKC( plan.status == plan_status::RUNNING || plan.status == plan_status::SUSPENDED, err::PAUSED, "temporarily suspended" )
+      auto state = plan_state_t( save_acct.plan_id );
+      CHECKC( _get_plan( state ), err::RECORD_NOT_FOUND, "plan not found: " + to_string(save_acct.plan_id) )
+      CHECKC( state.status == plan_status::RUNNING || state.status == plan_status::SUSPENDED, err::PAUSED, "temporarily suspended" )
+      auto plan = plan_conf_t( save_acct.plan_id );
+      CHECKC( _get_plan( plan ), err::RECORD_NOT_FOUND, "plan not found: " + to_string(save_acct.plan_id) )
 
-      CHECKC( save_acct.term_ended_at < current_time_point(), amaxsavetwo_err::TERM_NOT_ENDED, "term not ended" )
-      CHECKC( save_acct.term_ended_at <= save_acct.last_collected_at, amaxsavetwo_err::INTEREST_NOT_COLLECTED, "interest not collected" )
+      CHECKC( save_acct.term_ended_at() < current_time_point(), amaxsavetwo_err::TERM_NOT_ENDED, "term not ended" )
+      CHECKC( save_acct.term_ended_at() <= save_acct.last_collected_at(), amaxsavetwo_err::INTEREST_NOT_COLLECTED, "interest not collected" )
       
-      auto pledged_quant = save_acct.pledged;
+      auto pledged_quant = asset( save_acct.pledged, plan.stake_symbol.get_symbol() );
       _db.del( owner.value, save_acct );
+      _db.del( save_index_t(save_id) );
+
+      _roll_daily_stats(state);
+      state.pledged_total         -= save_acct.pledged;
+      state.interest_alloted      -= save_acct.interest_alloted;
+      state.active_positions      -= 1;
+      _db.set( state );
       
       TRANSFER( plan.stake_symbol.get_contract(), owner, pledged_quant, "redeem: " + to_string(save_id) )
   }
   
+  void amax_savetwo::crank(const uint64_t& plan_id, const uint64_t& cursor, const uint32_t& max_rows) {
+      require_auth( _gstate.admin );
+      CHECKC( max_rows > 0, err::PARAM_ERROR, "max_rows must be greater than 0" )
+
+      auto state = plan_state_t( plan_id );
+      CHECKC( _get_plan( state ), err::RECORD_NOT_FOUND, "plan not found: " + to_string(plan_id) )
+      CHECKC( state.status == plan_status::RUNNING || state.status == plan_status::SUSPENDED, err::PAUSED, "temporarily suspended" )
+      auto plan = plan_conf_t( plan_id );
+      CHECKC( _get_plan( plan ), err::RECORD_NOT_FOUND, "plan not found: " + to_string(plan_id) )
+
+      save_index_t::tbl_t save_idx_tbl(_self, _self.value);
+      auto term_idx = save_idx_tbl.get_index<"planterm"_n>();
+
+      //cursor is the save id + 1 to resume from, 0 starts over
+      auto lower = make256key(plan_id, 0, 0, 0);
+      if (cursor > 0) {
+          auto cursor_itr = save_idx_tbl.find( cursor - 1 );
+          if (cursor_itr != save_idx_tbl.end() && cursor_itr->plan_id == plan_id)
+              lower = cursor_itr->by_plan_term();
+      }
+
+      _roll_daily_stats(state);
+
+      auto now = current_time_point();
+      map<name, int64_t> interests;     //interest collected per owner
+      map<name, int64_t> redeems;       //principal redeemed per owner
+
+      auto itr = term_idx.lower_bound( lower );
+      for (uint32_t rows = 0; itr != term_idx.end() && itr->plan_id == plan_id && rows < max_rows; rows++) {
+          auto owner      = itr->owner;
+          auto save_acct  = save_account_t( itr->save_id );
+          if ( !_db.get( owner.value, save_acct ) ) {
+              itr = term_idx.erase( itr );
+              continue;
+          }
+
+          auto interest_due = save_acct.calc_due_interest();
+          auto collected    = interest_due > 0 && state.calc_available_interest() >= interest_due;
+          if ( collected ) {
+              save_acct.interest_collected    += interest_due;
+              save_acct.set_last_collected_at( now );
+              state.interest_collected        += interest_due;
+              interests[owner]                += interest_due;
+          }
+
+          if ( save_acct.term_ended_at() < now && save_acct.term_ended_at() <= save_acct.last_collected_at() ) {
+              _db.del( owner.value, save_acct );
+              itr = term_idx.erase( itr );
+
+              state.pledged_total     -= save_acct.pledged;
+              state.interest_alloted  -= save_acct.interest_alloted;
+              state.active_positions  -= 1;
+              redeems[owner]          += save_acct.pledged;
+          } else {
+              if ( collected ) _db.set( owner.value, save_acct );
+              itr++;
+          }
+      }
+      _db.set( state );
+
+      for (auto& [owner, interest] : interests) {
+          auto interest_quant = asset( interest, plan.interest_symbol.get_symbol() );
+          TRANSFER( plan.interest_symbol.get_contract(), owner, interest_quant, "interest: plan " + to_string(plan_id) )
+          _int_coll_log(owner, BATCH_SAVE_ID, plan_id, interest_quant);
+      }
+
+      for (auto& [owner, pledged] : redeems) {
+          auto pledged_quant = asset( pledged, plan.stake_symbol.get_symbol() );
+          TRANSFER( plan.stake_symbol.get_contract(), owner, pledged_quant, "redeem: plan " + to_string(plan_id) )
+      }
+
+      auto crank_cursor = plan_crank_t( plan_id );
+      crank_cursor.next_cursor    = ( itr != term_idx.end() && itr->plan_id == plan_id ) ? itr->save_id + 1 : 0;
+      crank_cursor.cranked_at     = now;
+      _db.set( crank_cursor, _self );
+  }
+
+  void amax_savetwo::migrate(const name& owner, const uint64_t& cursor, const uint32_t& max_rows) {
+      require_auth( _gstate.admin );
+      CHECKC( max_rows > 0, err::PARAM_ERROR, "max_rows must be greater than 0" )
+
+      save_account_v1_t::tbl_t legacy_accts(_self, owner.value);
+      save_account_t::tbl_t save_accts(_self, owner.value);
+
+      auto itr = legacy_accts.lower_bound( cursor );
+      for (uint32_t rows = 0; itr != legacy_accts.end() && rows < max_rows; rows++) {
+          auto save_acct = save_account_t( *itr );
+          save_accts.emplace( _self, [&]( auto& a ) { a = save_acct; });
+          _set_save_index( owner, save_acct );
+          _add_position( save_acct );
+          itr = legacy_accts.erase( itr );
+      }
+  }
+
+  void amax_savetwo::migrateplan(const uint64_t& plan_id) {
+      require_auth( _gstate.admin );
+
+      plan_conf_t plan(plan_id);
+      CHECKC( !_db.get( plan ), err::RECORD_FOUND, "plan already migrated: " + to_string( plan_id ) )
+      CHECKC( _migrate_plan( plan_id ), err::RECORD_NOT_FOUND, "legacy plan not found: " + to_string( plan_id ) )
+  }
+
   void amax_savetwo::intcolllog(const name& account, const uint64_t& account_id, const uint64_t& plan_id, const asset &quantity) {
       require_auth(get_self());
       require_recipient(account);
   }
 
+  bool amax_savetwo::_migrate_plan(const uint64_t& plan_id) {
+      save_plan_t legacy_plan(plan_id);
+      if ( !_db.get( legacy_plan ) ) return false;
+
+      plan_conf_t plan(plan_id);
+      plan.plan_name          = legacy_plan.plan_name;
+      plan.interest_symbol    = legacy_plan.interest_symbol;
+      plan.stake_symbol       = legacy_plan.stake_symbol;
+      plan.lquidity_extsym    = legacy_plan.lquidity_extsym;
+      plan.plan_days          = legacy_plan.plan_days;
+      plan.plan_profit        = legacy_plan.plan_profit;
+      plan.total_quotas       = legacy_plan.total_quotas;
+      plan.stake_per_quota    = legacy_plan.stake_per_quota;
+      plan.apl_per_quota      = legacy_plan.apl_per_quota;
+      plan.type               = legacy_plan.type;
+      plan.begin_at           = legacy_plan.begin_at;
+      plan.end_at             = legacy_plan.end_at;
+      plan.created_at         = legacy_plan.created_at;
+      _db.set( plan );
+
+      plan_state_t state(plan_id);
+      state.quotas_purchased   = legacy_plan.quotas_purchased;
+      state.interest_total     = legacy_plan.interest_total.amount;
+      state.interest_collected = legacy_plan.interest_collected.amount;
+      state.status             = legacy_plan.status;
+      _db.set( state );
+
+      _db.del( legacy_plan );
+      return true;
+  }
+
+  bool amax_savetwo::_get_plan(plan_conf_t& plan) {
+      if ( _db.get( plan ) ) return true;
+      return _migrate_plan( plan.id ) && _db.get( plan );
+  }
+
+  bool amax_savetwo::_get_plan(plan_state_t& state) {
+      if ( _db.get( state ) ) return true;
+      return _migrate_plan( state.id ) && _db.get( state );
+  }
+
+  void amax_savetwo::_set_save_index(const name& owner, const save_account_t& save_acct) {
+      save_index_t save_idx( save_acct.id );
+      save_idx.owner            = owner;
+      save_idx.plan_id          = save_acct.plan_id;
+      save_idx.term_ended_at    = save_acct.term_ended_at();
+      _db.set( save_idx, _self );
+  }
+
+  void amax_savetwo::_add_position(const save_account_t& save_acct) {
+      plan_state_t state( save_acct.plan_id );
+      CHECKC( _get_plan( state ), err::RECORD_NOT_FOUND, "plan not found: " + to_string( save_acct.plan_id ) )
+
+      _roll_daily_stats(state);
+      state.pledged_total         += save_acct.pledged;
+      state.interest_alloted      += save_acct.interest_alloted;
+      state.active_positions      += 1;
+      _db.set( state );
+  }
+
+  void amax_savetwo::_roll_daily_stats(plan_state_t& state) {
+      uint32_t today = current_time_point().sec_since_epoch() / DAY_SECONDS;
+      if (state.stats_day == today) return;
+
+      if (state.stats_day > 0) {
+          daily_stats_t::tbl_t stats_tbl( _self, state.id );
+          //idle days carry the closing values with zero inflow, up to MAX_STATS_FILL_DAYS rows
+          for (uint32_t day = state.stats_day; day < today && day < state.stats_day + MAX_STATS_FILL_DAYS; day++) {
+              daily_stats_t stats( day );
+              stats.pledged_total       = state.pledged_total;
+              stats.interest_alloted    = state.interest_alloted;
+              stats.interest_collected  = state.interest_collected;
+              stats.active_positions    = state.active_positions;
+              stats.day_pledged         = day == state.stats_day ? state.day_pledged : 0;
+              stats_tbl.emplace( _self, [&]( auto& s ) { s = stats; });
+          }
+      }
+
+      state.stats_day     = today;
+      state.day_pledged   = 0;
+  }
+
+  bool amax_savetwo::_get_save_acct(const name& owner, save_account_t& save_acct) {
+      if ( _db.get( owner.value, save_acct ) ) return true;
+
+      save_account_v1_t legacy_acct( save_acct.id );
+      if ( !_db.get( owner.value, legacy_acct ) ) return false;
+
+      save_acct = save_account_t( legacy_acct );
+      _db.del( owner.value, legacy_acct );
+      _db.set( owner.value, save_acct, false );
+      _set_save_index( owner, save_acct );
+      _add_position( save_acct );
+      return true;
+  }
+
   void amax_savetwo::_create_plan( const string &plan_name, 
                                         const name &type, 
                                         const extended_symbol &stake_symbol,
@@ -259,7 +480,7 @@ using namespace wasm::safemath;
                                         const uint32_t &begin_at,
                                         const uint32_t &end_at) {
       auto cid = _gstate.last_plan_id++;
-      save_plan_t plan(cid);
+      plan_conf_t plan(cid);
 
       plan.plan_name          = plan_name;
       plan.plan_days          = plan_days;
@@ -271,13 +492,14 @@ using namespace wasm::safemath;
       plan.apl_per_quota      = apl_per_quota;
       plan.begin_at           = time_point_sec(begin_at);
       plan.end_at             = time_point_sec(end_at);
-      plan.interest_total     = asset(0, interest_symbol.get_symbol());
-      plan.interest_collected = asset(0, interest_symbol.get_symbol());
       plan.created_at         = current_time_point();
       _db.set(plan);
+
+      _db.set(plan_state_t(cid));
   }
   
-  void amax_savetwo::_create_save_act(save_plan_t &plan,
+  void amax_savetwo::_create_save_act(const plan_conf_t &plan,
+                                      plan_state_t &state,
                                       const asset &quantity,
                                       const name &from,                                 
                                       const uint32_t &quotas,
@@ -285,18 +507,23 @@ using namespace wasm::safemath;
       auto sid = _gstate.last_save_id++;
       save_account_t save_acct(sid);
       save_acct.plan_id                     = plan.id;
-      save_acct.pledged                     = quantity;
+      save_acct.pledged                     = quantity.amount;
       save_acct.quotas                      = quotas;
-      save_acct.plan_term_days              = plan.plan_days;
-      save_acct.interest_alloted            = plan.plan_profit * quotas;
-      save_acct.interest_collected          = asset(0, plan.interest_symbol.get_symbol());
-      save_acct.term_ended_at               = now + plan.plan_days * DAY_SECONDS;
+      save_acct.interest_alloted            = (plan.plan_profit * quotas).amount;
+      save_acct.interest_collected          = 0;
       save_acct.created_at                  = now;
-      save_acct.last_collected_at           = now;
+      save_acct.term_days                   = plan.plan_days;
+      save_acct.collected_secs              = 0;
       _db.set( from.value, save_acct, false );
+      _set_save_index( from, save_acct );
       
-      plan.quotas_purchased += quotas;
-      _db.set( plan );
+      _roll_daily_stats(state);
+      state.quotas_purchased      += quotas;
+      state.pledged_total         += save_acct.pledged;
+      state.interest_alloted      += save_acct.interest_alloted;
+      state.active_positions      += 1;
+      state.day_pledged           += save_acct.pledged;
+      _db.set( state );
       
       if(_gstate.farm_lease_id > 0 && plan.apl_per_quota.amount > 0){
          asset apl = plan.apl_per_quota * quotas;
@@ -306,16 +533,76 @@ using namespace wasm::safemath;
   }
     
   void amax_savetwo::_allot_apl(asset apl, const name& from, const uint64_t& sid) {
-      
+      if (apl.amount <= 0) return;
+
+      //always kept pending, flushapl allots whatever the farm can afford
+      auto pending = apl_pending_t(from);
+      if ( !_db.get( pending ) )
+          pending.apples = asset(0, APLINK_SYMBOL);
+
+      pending.apples             += apl;
+      pending.last_save_id        = sid;
+      pending.updated_at          = current_time_point();
+      _db.set( pending, _self );
+
+      farm_cache_singleton farm_cache(_self, _self.value);
+      auto cache = farm_cache.get_or_default();
+      _refresh_farm_cache(cache);
+      cache.available_apples      = cache.available_apples > apl ? cache.available_apples - apl : asset(0, APLINK_SYMBOL);
+      cache.pending_apples       += apl;
+      farm_cache.set( cache, _self );
+  }
+
+  void amax_savetwo::_refresh_farm_cache(farm_cache_t& cache) {
+      auto now = current_time_point();
+      if (cache.refreshed_at == now) return;
+
       asset apples = asset(0, APLINK_SYMBOL);
-      name  parent = get_account_creator(from);
       aplink::farm::available_apples(APLINK_FARM, _gstate.farm_lease_id, apples);
-      
-      if (apples >= apl && apl.amount > 0) {
+
+      cache.available_apples  = apples > cache.pending_apples ? apples - cache.pending_apples : asset(0, APLINK_SYMBOL);
+      cache.refreshed_at      = now;
+  }
+
+  void amax_savetwo::flushapl(const uint32_t& max_rows) {
+      require_auth( _gstate.admin );
+      CHECKC( max_rows > 0, err::PARAM_ERROR, "max_rows must be greater than 0" )
+      CHECKC( _gstate.farm_lease_id > 0, err::STATE_MISMATCH, "farm lease not set" )
+
+      asset apples = asset(0, APLINK_SYMBOL);
+      aplink::farm::available_apples(APLINK_FARM, _gstate.farm_lease_id, apples);
+
+      farm_cache_singleton farm_cache(_self, _self.value);
+      auto cache = farm_cache.get_or_default();
+
+      apl_pending_t::tbl_t pendings(_self, _self.value);
+      auto itr = pendings.begin();
+      uint32_t rows = 0;
+      for (; itr != pendings.end() && rows < max_rows && apples.amount > 0; rows++) {
+          //allot what the farm can afford, the remainder stays at the head for the next flush
+          auto allot  = apples < itr->apples ? apples : itr->apples;
+          auto parent = get_account_creator(itr->pledger);
+
           ALLOT(  APLINK_FARM, _gstate.farm_lease_id,
-                  parent, apl,
-                  "amax save #2 allot: " + to_string( sid ));
+                  parent, allot,
+                  "amax save #2 allot: " + to_string( itr->last_save_id ) );
+
+          apples               -= allot;
+          cache.pending_apples -= allot;
+          if (allot < itr->apples) {
+              pendings.modify( itr, same_payer, [&]( auto& p ) {
+                  p.apples       -= allot;
+                  p.updated_at    = current_time_point();
+              });
+              rows++;
+              break;
+          }
+          itr = pendings.erase(itr);
       }
+      CHECKC( rows > 0, err::NOT_POSITIVE, "no pending apl to allot" )
+
+      cache.refreshed_at = time_point();   //farm balance changed, re-read on next pledge
+      farm_cache.set( cache, _self );
   }
   
   void amax_savetwo::_int_coll_log(const name& account, const uint64_t& account_id, const uint64_t& plan_id, const asset &quantity) {
@@ -122,6 +122,13 @@ class [[eosio::contract("amax.ntoken")]] ntoken : public contract {
       return amount; 
    }
 
+   static bool parent_exists( const name& contract, const uint32_t& parent_id ) { 
+      auto ntable = amax::nstats_t::idx_t( contract, contract.value ); 
+      auto idx = ntable.get_index<"parentidx"_n>(); 
+      auto itr = idx.find( parent_id ); 
+      return itr != idx.end() && itr->supply.symbol.parent_id == parent_id; 
+   }
+
    static set<amax::extended_nsymbol> get_syms_by_parent( const name& contract, const uint32_t& parent_id ) { 
       auto ntable = amax::nstats_t::idx_t( contract, contract.value ); 
       auto idx = ntable.get_index<"parentidx"_n>(); 
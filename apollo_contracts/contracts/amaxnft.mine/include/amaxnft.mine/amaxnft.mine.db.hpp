@@ -2,6 +2,7 @@
 
 #include <amax.ntoken/amax.nasset.hpp>
 #include <eosio/asset.hpp>
+#include <eosio/binary_extension.hpp>
 #include <eosio/privileged.hpp>
 #include <eosio/singleton.hpp>
 #include <eosio/system.hpp>
@@ -28,6 +29,7 @@ using namespace eosio;
 static constexpr uint64_t DAY_SECONDS  = 24 * 60 * 60;
 static constexpr uint64_t YEAR_SECONDS = 365 * 24 * 60 * 60;
 static constexpr uint64_t YEAR_DAYS    = 365;
+static constexpr uint128_t PRE_INTEREST_SCALE = 1'000'000'000'000'000'000; // 1e18, scale of per share interest accumulators
 
 namespace campaign_status {
    static constexpr eosio::name INIT    = "init"_n;
@@ -61,7 +63,8 @@ struct quotas {
 };
 
 // scope: self
-SAVE_TBL save_campaign_t {
+// Note: legacy row, converted into save_campaign_t, campaign_meta_t and campaign_ntoken_t on first touch
+SAVE_TBL save_campaign_v1_t {
    uint64_t                      id; // pk
    name                          sponsor;              // campaign creater
    string                        campaign_name_cn;     // campaign chinese name
@@ -75,12 +78,75 @@ SAVE_TBL save_campaign_t {
    uint32_t                      total_quotas;         // total quotas
    uint32_t                      quotas_purchased = 0; // purchased or pledged quotas
    asset                         interest_total;       // bonus total interest
-   asset                         pre_interest;         // interest per share
+   asset                         pre_interest;         // legacy interest per share, superseded by pre_interest_acc
+   asset                         interest_collected;   // collected interest
+   name                          status;     // campaign status (1)init : fee paid； (2)created : campaign content edited; (3)append : add interest token
+   time_point_sec                begin_at;   // begin timestamp
+   time_point_sec                end_at;     // end timestamp
+   time_point_sec                created_at; // create timestamp
+   binary_extension<uint128_t>   pre_interest_acc;     // interest per share * PRE_INTEREST_SCALE
+   binary_extension<uint128_t>   pre_interest_rem;     // refuel remainder carried to the next refuel, < quotas_purchased
+
+   save_campaign_v1_t() {}
+   save_campaign_v1_t(const uint64_t& i) : id(i) {}
+
+   uint64_t primary_key() const { return id; }
+   uint64_t scope() const { return 0; }
+
+   uint128_t get_pre_interest() const {
+      return pre_interest_acc.has_value() ? pre_interest_acc.value() : (uint128_t)pre_interest.amount * PRE_INTEREST_SCALE;
+   }
+
+   typedef multi_index<"minecampaign"_n, save_campaign_v1_t> tbl_t;
+
+   EOSLIB_SERIALIZE(
+         save_campaign_v1_t,
+         (id)(sponsor)(campaign_name_cn)(campaign_name_en)(campaign_pic_url_cn)(campaign_pic_url_en)
+         (pledge_ntokens)(interest_symbol)(plan_day)(plan_interest)(total_quotas)(quotas_purchased)(interest_total)
+         (pre_interest)(interest_collected)(status)(begin_at)(end_at)(created_at)(pre_interest_acc)(pre_interest_rem))
+};
+
+// sponsor deposit released linearly into pre_interest between start_at and end_at
+struct interest_release {
+   asset          quantity;   // deposited interest, rate = quantity / (end_at - start_at)
+   asset          released;   // interest already due, spread into pre_interest_acc or skipped
+   time_point_sec start_at;   // release start timestamp
+   time_point_sec end_at;     // release end timestamp
+   asset          skipped;    // part of released due while nothing was pledged, released again once pledges resume
+
+   // interest due for release at now, not yet spread
+   int64_t calc_releasable(const time_point_sec& now) const {
+      if (now <= start_at) return 0;
+      uint32_t elapsed  = std::min(now, end_at).sec_since_epoch() - start_at.sec_since_epoch();
+      uint32_t duration = end_at.sec_since_epoch() - start_at.sec_since_epoch();
+      int64_t  target   = (int64_t)((uint128_t)quantity.amount * elapsed / duration);
+      return target - released.amount;
+   }
+
+   bool is_finished() const { return released >= quantity; }
+
+   EOSLIB_SERIALIZE(interest_release, (quantity)(released)(start_at)(end_at)(skipped))
+};
+
+// scope: self
+// Note: fixed size hot state, written by pledge, refuel, collect and redeem
+SAVE_TBL save_campaign_t {
+   uint64_t                      id; // pk
+   name                          sponsor;              // campaign creater
+   extended_symbol               interest_symbol;      // interest symbol
+   uint16_t                      plan_day;             // plan limit days
+   asset                         plan_interest;        // plan interest asset
+   uint32_t                      total_quotas;         // total quotas
+   uint32_t                      quotas_purchased = 0; // purchased or pledged quotas
+   asset                         interest_total;       // bonus total interest
    asset                         interest_collected;   // collected interest
+   uint128_t                     pre_interest_acc = 0; // interest per share * PRE_INTEREST_SCALE
+   uint128_t                     pre_interest_rem = 0; // refuel remainder carried to the next refuel, < quotas_purchased
    name                          status;     // campaign status (1)init : fee paid； (2)created : campaign content edited; (3)append : add interest token
    time_point_sec                begin_at;   // begin timestamp
    time_point_sec                end_at;     // end timestamp
    time_point_sec                created_at; // create timestamp
+   binary_extension<interest_release> release; // scheduled sponsor refuel
 
    save_campaign_t() {}
    save_campaign_t(const uint64_t& i) : id(i) {}
@@ -91,13 +157,108 @@ SAVE_TBL save_campaign_t {
    uint32_t calc_available_quotas() const { return total_quotas - quotas_purchased; }
    asset    calc_available_interest() const { return interest_total - interest_collected; }
 
-   typedef multi_index<"minecampaign"_n, save_campaign_t> tbl_t;
+   uint128_t get_pre_interest() const { return pre_interest_acc; }
+
+   // spread quantity over quotas_purchased, keeping the division remainder for the next refuel
+   void add_pre_interest(const asset& quantity) {
+      uint128_t total = (uint128_t)quantity.amount * PRE_INTEREST_SCALE + pre_interest_rem;
+      pre_interest_acc += total / quotas_purchased;
+      pre_interest_rem  = total % quotas_purchased;
+   }
+
+   // spread the scheduled refuel elapsed up to now; the schedule runs on time, the part due
+   // while nothing is pledged is skipped so the first pledger does not capture it
+   void release_interest(const time_point_sec& now) {
+      if (!release.has_value()) return;
+      auto& sched = release.value();
+      int64_t amount = sched.calc_releasable(now);
+      if (amount <= 0) return;
+      if (quotas_purchased > 0)
+         add_pre_interest(asset(amount, sched.quantity.symbol));
+      else
+         sched.skipped.amount += amount;
+      sched.released.amount += amount;
+   }
+
+   // pledges resumed: what was skipped is released again from now, over the rest of the schedule,
+   // or over another period of the same length once the schedule has ended
+   void resume_release(const time_point_sec& now) {
+      if (!release.has_value() || quotas_purchased == 0) return;
+      auto& sched = release.value();
+      if (sched.skipped.amount <= 0) return;
+      uint32_t duration = sched.end_at.sec_since_epoch() - sched.start_at.sec_since_epoch();
+      sched.quantity    = sched.quantity - sched.released + sched.skipped;
+      sched.released    = asset(0, sched.quantity.symbol);
+      sched.skipped     = asset(0, sched.quantity.symbol);
+      if (now >= sched.end_at) sched.end_at = now + duration;
+      sched.start_at    = now;
+   }
+
+   typedef multi_index<"campstate"_n, save_campaign_t> tbl_t;
 
    EOSLIB_SERIALIZE(
          save_campaign_t,
-         (id)(sponsor)(campaign_name_cn)(campaign_name_en)(campaign_pic_url_cn)(campaign_pic_url_en)
-         (pledge_ntokens)(interest_symbol)(plan_day)(plan_interest)(total_quotas)(quotas_purchased)(interest_total)
-         (pre_interest)(interest_collected)(status)(begin_at)(end_at)(created_at))
+         (id)(sponsor)(interest_symbol)(plan_day)(plan_interest)(total_quotas)(quotas_purchased)(interest_total)
+         (interest_collected)(pre_interest_acc)(pre_interest_rem)(status)(begin_at)(end_at)(created_at)(release))
+};
+
+// scope: self
+// Note: display metadata, written by setcampaign only
+SAVE_TBL campaign_meta_t {
+   uint64_t       campaign_id;          // pk, save_campaign_t.id
+   string         campaign_name_cn;     // campaign chinese name
+   string         campaign_name_en;     // campaign english name
+   string         campaign_pic_url_cn;  // campaign chinese picture
+   string         campaign_pic_url_en;  // campaign english picture
+
+   campaign_meta_t() {}
+   campaign_meta_t(const uint64_t& i) : campaign_id(i) {}
+
+   uint64_t primary_key() const { return campaign_id; }
+   uint64_t scope() const { return 0; }
+
+   typedef multi_index<"campmeta"_n, campaign_meta_t> tbl_t;
+
+   EOSLIB_SERIALIZE(campaign_meta_t, (campaign_id)(campaign_name_cn)(campaign_name_en)(campaign_pic_url_cn)(campaign_pic_url_en))
+};
+
+// scope: campaign_id
+// Note: explicit pledge ntoken list, replaces save_campaign_v1_t.pledge_ntokens
+SAVE_TBL campaign_ntoken_t {
+   extended_nsymbol  symbol;            // pledge ntoken
+   quotas            quota;             // pledged and redeemed quotas of the ntoken
+
+   campaign_ntoken_t() {}
+   campaign_ntoken_t(const extended_nsymbol& s) : symbol(s) {}
+
+   uint64_t primary_key() const { return symbol.get_nsymbol().raw(); }
+
+   typedef multi_index<"campntokens"_n, campaign_ntoken_t> tbl_t;
+
+   EOSLIB_SERIALIZE(campaign_ntoken_t, (symbol)(quota))
+};
+
+// scope: self
+// Note: campaign accepts every nft whose nsymbol.parent_id matches
+SAVE_TBL campaign_parent_t {
+   uint64_t       campaign_id;          // pk, save_campaign_t.id
+   name           ntoken_contract;      // nft contract of the collection
+   uint32_t       parent_id;            // nsymbol.parent_id of the collection
+   quotas         quota;                // pledged and redeemed quotas of the collection
+
+   campaign_parent_t() {}
+   campaign_parent_t(const uint64_t& i) : campaign_id(i) {}
+
+   uint64_t primary_key() const { return campaign_id; }
+   uint64_t scope() const { return 0; }
+
+   bool match(const extended_nsymbol& sym) const {
+      return sym.get_contract() == ntoken_contract && sym.get_nsymbol().parent_id == parent_id;
+   }
+
+   typedef multi_index<"campparent"_n, campaign_parent_t> tbl_t;
+
+   EOSLIB_SERIALIZE(campaign_parent_t, (campaign_id)(ntoken_contract)(parent_id)(quota))
 };
 
 // Scope: account
@@ -106,27 +267,35 @@ SAVE_TBL save_account_t {
    uint64_t        id; // PK
    uint64_t        campaign_id;       // save_campaign_t.id
    extended_nasset pledged;           // amount == quotas
-   asset           save_pre_interest; // save interest per share
+   asset           save_pre_interest; // legacy interest per share at pledge, superseded by save_pre_interest_acc
    asset           interest_collected; // collected interest
    time_point_sec  term_ended_at;      // redeemable timestamp
    time_point_sec  last_collected_at;  // last collected timestamp
    time_point_sec  created_at;         // create timestamp
+   binary_extension<uint128_t> save_pre_interest_acc; // campaign pre_interest_acc at pledge
 
    save_account_t() {}
    save_account_t(const uint64_t& i) : id(i) {}
 
    uint64_t primary_key() const { return id; }
 
-   // (save_campaign_t.pre_interest - save_pre_interest) * extended_nasset - interest_collected
-   asset calc_due_interest(const asset& camp_pre_interest) const {
-      auto interest = (camp_pre_interest - save_pre_interest) * pledged.quantity.amount - interest_collected;
-      return interest;
+   uint128_t get_save_pre_interest() const {
+      return save_pre_interest_acc.has_value() ? save_pre_interest_acc.value() : (uint128_t)save_pre_interest.amount * PRE_INTEREST_SCALE;
+   }
+
+   // (save_campaign_t.pre_interest - save_pre_interest) * extended_nasset / PRE_INTEREST_SCALE - interest_collected
+   asset calc_due_interest(const uint128_t& camp_pre_interest) const {
+      uint128_t delta = camp_pre_interest - get_save_pre_interest();
+      CHECK( delta <= std::numeric_limits<uint128_t>::max() / (uint128_t)pledged.quantity.amount, "overflow exception of pre interest" )
+      int64_t earned  = (int64_t)(delta * pledged.quantity.amount / PRE_INTEREST_SCALE);
+      return asset(earned, interest_collected.symbol) - interest_collected;
    }
 
    typedef multi_index<"mineaccounts"_n, save_account_t> tbl_t;
 
    EOSLIB_SERIALIZE(save_account_t,
-                    (id)(campaign_id)(pledged)(save_pre_interest)(interest_collected)(term_ended_at)(last_collected_at)(created_at))
+                    (id)(campaign_id)(pledged)(save_pre_interest)(interest_collected)(term_ended_at)(last_collected_at)(created_at)
+                    (save_pre_interest_acc))
 };
 
 } // namespace amax
@@ -72,6 +72,16 @@ class [[eosio::contract("amaxnft.mine")]] amaxnft_mine : public contract {
                       const string& campaign_name_cn, const string& campaign_name_en, const string& campaign_pic_url_cn,
                       const string& campaign_pic_url_en, const uint32_t& begin_at, const uint32_t& end_at);
 
+   /**
+    * @brief accept every nft of a collection, validated by nsymbol.parent_id instead of an id list
+    *
+    * @param sponsor  campaign sponsor.
+    * @param campaign_id  campaign id.
+    * @param ntoken_contract  nft contract of the collection.
+    * @param parent_id  parent id of the collection.
+    */
+   ACTION setcampparent(const name& sponsor, const uint64_t& campaign_id, const name& ntoken_contract, const uint32_t& parent_id);
+
    /**
     * @brief user claim interest
     *
@@ -87,8 +97,9 @@ class [[eosio::contract("amaxnft.mine")]] amaxnft_mine : public contract {
     * @param issuer  users participating in the campaign.
     * @param owner  users participating in the campaign.
     * @param save_id  save account id.
+    * @param collect  optional, transfer the due interest together with the nft instead of requiring it collected.
     */
-   ACTION redeem(const name& issuer, const name& owner, const uint64_t& save_id);
+   ACTION redeem(const name& issuer, const name& owner, const uint64_t& save_id, const binary_extension<bool>& collect);
 
    /**
     * @brief only contract owner can change nft user account
@@ -99,6 +110,25 @@ class [[eosio::contract("amaxnft.mine")]] amaxnft_mine : public contract {
     */
    ACTION changeacct(const name& owner, const name& new_owner, const uint64_t& save_id);
 
+   /**
+    * @brief only contract owner can change nft user account of several save accounts
+    *
+    * @param owner     users participating in the campaign.
+    * @param new_owner new users participating in the campaign.
+    * @param save_ids  save account ids.
+    */
+   ACTION changeaccts(const name& owner, const name& new_owner, const vector<uint64_t>& save_ids);
+
+   /**
+    * @brief only contract owner can move all save accounts of owner to new_owner
+    *
+    * @param owner     users participating in the campaign.
+    * @param new_owner new users participating in the campaign.
+    * @param cursor    save account id to start from; moved rows leave the owner scope, so 0 resumes.
+    * @param max_rows  max save accounts to move in this action.
+    */
+   ACTION changeall(const name& owner, const name& new_owner, const uint64_t& cursor, const uint32_t& max_rows);
+
    /**
     * @brief sponsor cancel campaign
     *
@@ -144,6 +174,12 @@ class [[eosio::contract("amaxnft.mine")]] amaxnft_mine : public contract {
                       const string_view& campaign_name_en, const string_view& campaign_pic_url_cn,
                       const string_view& campaign_pic_url_en);
 
+   void _change_acct(const name& owner, const name& new_owner, const save_account_t& save_acct);
+
+   bool _get_campaign(save_campaign_t& campaign);
+
+   void _del_campaign(const save_campaign_t& campaign);
+
    void _int_coll_log(const name& account, const uint64_t& account_id, const uint64_t& campaign_id,
                       const asset& quantity, const time_point& created_at);
    
@@ -76,9 +76,10 @@ using namespace wasm::safemath;
       require_auth(sponsor);
       
       save_campaign_t campaign(campaign_id);
-      CHECKC( _db.get( campaign ), err::RECORD_NOT_FOUND, "campaign not found: " + to_string( campaign_id ) )
+      CHECKC( _get_campaign( campaign ), err::RECORD_NOT_FOUND, "campaign not found: " + to_string( campaign_id ) )
       CHECKC( campaign.sponsor == sponsor, err::NO_AUTH, "permission denied" )
-      CHECKC( nftids.size() > 0, err::PARAM_ERROR, "nft size is zero");
+      campaign_parent_t camp_parent(campaign_id);
+      CHECKC( nftids.size() > 0 || _db.get( camp_parent ), err::PARAM_ERROR, "nft size is zero");
       
       bool is_created = campaign.status == campaign_status::CREATED or campaign.status == campaign_status::APPEND;
       CHECKC( end_at > begin_at, err::PARAM_ERROR, "begin time should be less than end time");
@@ -102,7 +103,7 @@ using namespace wasm::safemath;
       campaign.begin_at               = time_point_sec(begin_at);
       campaign.end_at                 = time_point_sec(end_at);
       if (is_created == false) {
-          campaign.pre_interest       = asset(power10(plan_interest.symbol.precision()), plan_interest.symbol); // default pre interest is 1
+          campaign.pre_interest_acc   = (uint128_t)power10(plan_interest.symbol.precision()) * PRE_INTEREST_SCALE; // default pre interest is 1
           campaign.interest_collected = asset(0, plan_interest.symbol);
           campaign.interest_total     = asset(0, plan_interest.symbol);
           campaign.status             = campaign_status::CREATED;
@@ -110,6 +111,26 @@ using namespace wasm::safemath;
       _db.set(campaign);
   }
 
+  // campaign creator accepts a whole nft collection
+  void amaxnft_mine::setcampparent(const name& sponsor, const uint64_t& campaign_id, const name& ntoken_contract, const uint32_t& parent_id)
+  {
+      require_auth(sponsor);
+
+      save_campaign_t campaign(campaign_id);
+      CHECKC( _get_campaign( campaign ), err::RECORD_NOT_FOUND, "campaign not found: " + to_string( campaign_id ) )
+      CHECKC( campaign.sponsor == sponsor, err::NO_AUTH, "permission denied" )
+      CHECKC( _gstate.nft_contracts.count(ntoken_contract), err::PARAM_ERROR, "ntoken contract invalid" )
+      CHECKC( ntoken::parent_exists(ntoken_contract, parent_id), err::RECORD_NOT_FOUND, "nft parent not found: " + to_string(parent_id) )
+
+      campaign_parent_t camp_parent(campaign_id);
+      if ( _db.get( camp_parent ) ) {
+          CHECKC( camp_parent.quota.allocated_quotas == camp_parent.quota.redeemed_quotas, save_err::NOT_EMPTY, "collection already pledged" )
+      }
+      camp_parent.ntoken_contract = ntoken_contract;
+      camp_parent.parent_id       = parent_id;
+      _db.set( camp_parent );
+  }
+
   // user earn interest
   void amaxnft_mine::collectint(const name& issuer, const name& owner, const uint64_t& save_id) {
       require_auth( issuer );
@@ -121,9 +142,9 @@ using namespace wasm::safemath;
       CHECKC( save_acct.last_collected_at + DAY_SECONDS <= time_point_sec(now), save_err::TERM_NOT_ENDED, "term not ended" )
 
       save_campaign_t campaign( save_acct.campaign_id );
-      CHECKC( _db.get( campaign ), err::RECORD_NOT_FOUND, "campaign not found: " + to_string( save_acct.campaign_id ) )
+      CHECKC( _get_campaign( campaign ), err::RECORD_NOT_FOUND, "campaign not found: " + to_string( save_acct.campaign_id ) )
 
-      auto interest_due = save_acct.calc_due_interest(campaign.pre_interest);
+      auto interest_due = save_acct.calc_due_interest(campaign.get_pre_interest());
       CHECKC( interest_due.amount > 0, err::NOT_POSITIVE, "interest due amount is zero" )
       ASSERT( campaign.calc_available_interest() >= interest_due )
       
@@ -140,7 +161,7 @@ using namespace wasm::safemath;
   }
   
   // user redemption nft
-  void amaxnft_mine::redeem(const name& issuer, const name& owner, const uint64_t& save_id) {
+  void amaxnft_mine::redeem(const name& issuer, const name& owner, const uint64_t& save_id, const binary_extension<bool>& collect) {
       require_auth( issuer );
       
       if ( issuer != owner ) {
@@ -152,19 +173,42 @@ using namespace wasm::safemath;
       CHECKC( save_acct.term_ended_at < current_time_point(), save_err::TERM_NOT_ENDED, "term not ended" )
 
       auto campaign = save_campaign_t( save_acct.campaign_id );
-      CHECKC( _db.get( campaign ), err::RECORD_NOT_FOUND, "plan not found: " + to_string(save_acct.campaign_id) )
+      CHECKC( _get_campaign( campaign ), err::RECORD_NOT_FOUND, "plan not found: " + to_string(save_acct.campaign_id) )
       auto pledged_quant = save_acct.pledged;
-      // check interest is zero
-      auto interest_due = save_acct.calc_due_interest(campaign.pre_interest);
-      CHECKC( interest_due.amount == 0, err::NOT_POSITIVE, "interest due amount is not zero" )
+      auto interest_due = save_acct.calc_due_interest(campaign.get_pre_interest());
+      bool is_collect   = collect.value_or(false) && interest_due.amount > 0;
+      if (is_collect) {
+          // settle the due interest with the same campaign write
+          ASSERT( campaign.calc_available_interest() >= interest_due )
+          campaign.interest_collected += interest_due;
+      } else {
+          // check interest is zero
+          CHECKC( interest_due.amount == 0, err::NOT_POSITIVE, "interest due amount is not zero" )
+      }
 
-      campaign.pledge_ntokens[pledged_quant.get_extended_nsymbol()].redeemed_quotas   += pledged_quant.quantity.amount;
+      campaign_ntoken_t camp_ntoken(pledged_quant.get_extended_nsymbol());
+      if ( _db.get( campaign.id, camp_ntoken ) && camp_ntoken.symbol == pledged_quant.get_extended_nsymbol() ) {
+          camp_ntoken.quota.redeemed_quotas += pledged_quant.quantity.amount;
+          _db.set( campaign.id, camp_ntoken );
+      } else {
+          // positions of a listing dropped as duplicate on conversion have no quota row left
+          campaign_parent_t camp_parent(campaign.id);
+          if ( _db.get( camp_parent ) && camp_parent.match(pledged_quant.get_extended_nsymbol()) ) {
+              camp_parent.quota.redeemed_quotas += pledged_quant.quantity.amount;
+              _db.set( camp_parent );
+          }
+      }
       campaign.quotas_purchased -= pledged_quant.quantity.amount;
       _db.set( campaign );
       _db.del( owner.value, save_acct );
       
       vector<nasset> redeem_quant = {pledged_quant.quantity};
       NTOKEN_TRANSFER( pledged_quant.contract, owner, redeem_quant, "redeem: " + to_string(save_id) )
+
+      if (is_collect) {
+          TRANSFER( campaign.interest_symbol.get_contract(), owner, interest_due, "interest: " + to_string(save_id) )
+          _int_coll_log(owner, save_id, campaign.id, interest_due, time_point_sec( current_time_point() ));
+      }
   }
 
   // only contract owner change nft user account
@@ -177,17 +221,41 @@ using namespace wasm::safemath;
       auto save_acct = save_account_t( save_id );
       CHECKC( _db.get( owner.value, save_acct ), err::RECORD_NOT_FOUND, "account save not found" )
 
-      save_account_t new_save_acct(save_id);
-      new_save_acct.campaign_id                 = save_acct.campaign_id;
-      new_save_acct.pledged                     = save_acct.pledged;
-      new_save_acct.save_pre_interest           = save_acct.save_pre_interest;
-      new_save_acct.interest_collected          = save_acct.interest_collected;
-      new_save_acct.term_ended_at               = save_acct.term_ended_at;
-      new_save_acct.last_collected_at           = save_acct.last_collected_at;
-      new_save_acct.created_at                  = save_acct.created_at;
+      _change_acct( owner, new_owner, save_acct );
+  }
 
-      _db.set( new_owner.value, new_save_acct, false);
-      _db.del( owner.value, save_acct );
+  // only contract owner change nft user accounts in bulk
+  void amaxnft_mine::changeaccts(const name& owner, const name& new_owner, const vector<uint64_t>& save_ids) {
+      require_auth( _self );
+
+      CHECKC( is_account(new_owner), err::ACCOUNT_INVALID, "new owner account not found: " + new_owner.to_string() )
+      CHECKC( owner.value != new_owner.value, err::PARAM_ERROR, "owner account is same" )
+      CHECKC( save_ids.size() > 0, err::PARAM_ERROR, "save_ids is empty" )
+
+      for (const auto& save_id : save_ids) {
+          auto save_acct = save_account_t( save_id );
+          CHECKC( _db.get( owner.value, save_acct ), err::RECORD_NOT_FOUND, "account save not found: " + to_string(save_id) )
+          _change_acct( owner, new_owner, save_acct );
+      }
+  }
+
+  // only contract owner move all nft user accounts of owner
+  void amaxnft_mine::changeall(const name& owner, const name& new_owner, const uint64_t& cursor, const uint32_t& max_rows) {
+      require_auth( _self );
+
+      CHECKC( is_account(new_owner), err::ACCOUNT_INVALID, "new owner account not found: " + new_owner.to_string() )
+      CHECKC( owner.value != new_owner.value, err::PARAM_ERROR, "owner account is same" )
+      CHECKC( max_rows > 0, err::PARAM_ERROR, "max_rows must be greater than 0" )
+
+      save_account_t::tbl_t save_accts(_self, owner.value);
+      auto itr = save_accts.lower_bound(cursor);
+      CHECKC( itr != save_accts.end(), err::RECORD_NOT_FOUND, "account save not found" )
+
+      for (uint32_t i = 0; i < max_rows && itr != save_accts.end(); i++) {
+          auto save_acct = *itr;
+          itr++;
+          _change_acct( owner, new_owner, save_acct );
+      }
   }
 
   // campaign creator cancel campaign
@@ -198,12 +266,12 @@ using namespace wasm::safemath;
       }
       
       save_campaign_t campaign(campaign_id);
-      CHECKC( _db.get( campaign ), err::RECORD_NOT_FOUND, "campaign not found: " + to_string( campaign_id ) )
+      CHECKC( _get_campaign( campaign ), err::RECORD_NOT_FOUND, "campaign not found: " + to_string( campaign_id ) )
       CHECKC( campaign.status == campaign_status::CREATED, err::STATE_MISMATCH, "status mismatch" )
       CHECKC( campaign.sponsor == owner, err::NO_AUTH, "permission denied" )
       CHECKC( campaign.begin_at > current_time_point(), save_err::STARTED, "campaign already started" )
       
-      _db.del( campaign );
+      _del_campaign( campaign );
   }
   
 
@@ -223,7 +291,7 @@ using namespace wasm::safemath;
       require_auth(sponsor);
       
       save_campaign_t campaign(campaign_id);
-      CHECKC( _db.get( campaign ), err::RECORD_NOT_FOUND, "campaign not found: " + to_string( campaign_id ) )
+      CHECKC( _get_campaign( campaign ), err::RECORD_NOT_FOUND, "campaign not found: " + to_string( campaign_id ) )
       CHECKC( campaign.sponsor == sponsor, err::NO_AUTH, "permission denied" )
       
       bool is_created = campaign.status == campaign_status::CREATED or campaign.status == campaign_status::APPEND;
@@ -247,6 +315,8 @@ using namespace wasm::safemath;
   * @param memo: three formats:
   *       1) create_campaign                  -- pre-creation campaign by transfer fee
   *       2) refuelint : $campaign_id         -- increment interest
+  *       3) refuelsched : $campaign_id : $start_at : $end_at   -- release interest linearly from start_at to end_at,
+  *                                                                plus what the previous schedule skipped while nothing was pledged
   */
  
   void amaxnft_mine::_on_token_transfer( const name &from,
@@ -272,16 +342,15 @@ using namespace wasm::safemath;
 
           uint64_t campaign_id = to_uint64(parts[1], "campaign_id parse int error");
           save_campaign_t campaign(campaign_id);
-          CHECKC( _db.get( campaign ), err::RECORD_NOT_FOUND, "campaign not found: " + to_string( campaign_id ) )
+          CHECKC( _get_campaign( campaign ), err::RECORD_NOT_FOUND, "campaign not found: " + to_string( campaign_id ) )
           CHECKC( campaign.sponsor == from || _is_whitelist(from), err::NO_AUTH, "permission denied" )
 
           // check quotas gt zero
           CHECKC(campaign.quotas_purchased > 0, err::OVERSIZED, "purchase quotas must be greater than 0" )
 
           // calc and update pre_interest
-          auto pre_quantity = quantity / campaign.quotas_purchased;
-          CHECKC(pre_quantity.amount > 0, err::OVERSIZED, "quantity must be greater than 0")
-          campaign.pre_interest += pre_quantity;
+          CHECKC(quantity.amount > 0, err::NOT_POSITIVE, "quantity must be greater than 0")
+          campaign.add_pre_interest(quantity);
           
           if(campaign.status == campaign_status::CREATED){
               campaign.interest_collected   = asset(0, quantity.symbol);
@@ -296,6 +365,37 @@ using namespace wasm::safemath;
 
           auto now = current_time_point();
           _int_refu_log( from, campaign_id, quantity, campaign.total_quotas, campaign.quotas_purchased, time_point_sec(current_time_point()) );
+      } else if ( parts.size() == 4 && parts[0] == "refuelsched" ) {
+
+          CHECKC( _gstate.interest_token_contracts.count(get_first_receiver()), err::PARAM_ERROR, "token contract invalid" )
+
+          uint64_t campaign_id = to_uint64(parts[1], "campaign_id parse int error");
+          auto start_at        = time_point_sec(to_uint64(parts[2], "start_at parse int error"));
+          auto end_at          = time_point_sec(to_uint64(parts[3], "end_at parse int error"));
+          auto now             = time_point_sec(current_time_point());
+          save_campaign_t campaign(campaign_id);
+          CHECKC( _get_campaign( campaign ), err::RECORD_NOT_FOUND, "campaign not found: " + to_string( campaign_id ) )
+          CHECKC( campaign.sponsor == from || _is_whitelist(from), err::NO_AUTH, "permission denied" )
+          CHECKC( campaign.status == campaign_status::CREATED or campaign.status == campaign_status::APPEND, err::STATE_MISMATCH, "state mismatch" )
+          CHECKC( end_at > start_at && start_at >= now, err::PARAM_ERROR, "invalid release period" )
+          CHECKC( quantity.amount > 0, err::NOT_POSITIVE, "quantity must be greater than 0" )
+          CHECKC( !campaign.release.has_value() || campaign.release.value().is_finished(), err::STATE_MISMATCH, "previous release not finished" )
+
+          if(campaign.status == campaign_status::CREATED){
+              campaign.interest_collected   = asset(0, quantity.symbol);
+              campaign.interest_symbol      = extended_symbol(quantity.symbol, get_first_receiver());
+              campaign.interest_total       = quantity;
+              campaign.status               = campaign_status::APPEND;
+          } else {
+              CHECKC( campaign.interest_symbol == extended_symbol(quantity.symbol, get_first_receiver()), err::SYMBOL_MISMATCH, "interest symbol mismatch" )
+              campaign.interest_total       += quantity;
+          }
+          // interest skipped by the previous schedule while nothing was pledged is released again
+          auto carried = campaign.release.has_value() ? campaign.release.value().skipped : asset(0, quantity.symbol);
+          campaign.release.emplace( interest_release{ quantity + carried, asset(0, quantity.symbol), start_at, end_at, asset(0, quantity.symbol) } );
+          _db.set(campaign);
+
+          _int_refu_log( from, campaign_id, quantity, campaign.total_quotas, campaign.quotas_purchased, now );
       } else {
           CHECKC( false, err::PARAM_ERROR, "param error" );
       }
@@ -327,18 +427,26 @@ using namespace wasm::safemath;
           auto campaign_id = to_uint64(parts[1], "campaign_id parse uint error");
           
           save_campaign_t campaign(campaign_id);
-          CHECKC( _db.get( campaign ), err::RECORD_NOT_FOUND, "campaign not found: " + to_string( campaign_id ) )
+          CHECKC( _get_campaign( campaign ), err::RECORD_NOT_FOUND, "campaign not found: " + to_string( campaign_id ) )
           CHECKC( campaign.status == campaign_status::CREATED or campaign.status == campaign_status::APPEND, err::STATE_MISMATCH, "state mismatch" )
           CHECKC( campaign.end_at >= now, save_err::ENDED, "the campaign already ended" )
           CHECKC( campaign.begin_at <= now, save_err::NOT_START, "the campaign not start" )
           CHECKC( quantity.amount <= campaign.calc_available_quotas(), save_err::QUOTAS_INSUFFICIENT, "quotas insufficient" )
-          CHECKC( campaign.pledge_ntokens.count(extended_quantity.get_extended_nsymbol()), err::PARAM_ERROR, "this ntoken does not exist" )
+          // explicit nft ids are tracked in campaign_ntoken_t, whole collections in campaign_parent_t
+          auto ext_nsymbol = extended_quantity.get_extended_nsymbol();
+          campaign_ntoken_t camp_ntoken(ext_nsymbol);
+          bool is_listed   = _db.get( campaign_id, camp_ntoken ) && camp_ntoken.symbol == ext_nsymbol;
+          campaign_parent_t camp_parent(campaign_id);
+          if (!is_listed) {
+              CHECKC( _db.get( camp_parent ) && camp_parent.match(ext_nsymbol), err::PARAM_ERROR, "this ntoken does not exist" )
+          }
           
           auto sid = _gstate.last_save_id++;
           save_account_t save_acct(sid);
           save_acct.campaign_id                 = campaign_id;
           save_acct.pledged                     = extended_quantity;
-          save_acct.save_pre_interest           = campaign.pre_interest;
+          save_acct.save_pre_interest           = asset((int64_t)(campaign.get_pre_interest() / PRE_INTEREST_SCALE), campaign.plan_interest.symbol);
+          save_acct.save_pre_interest_acc.emplace( campaign.get_pre_interest() );
           save_acct.interest_collected          = asset(0, campaign.plan_interest.symbol);
           save_acct.term_ended_at               = now + campaign.plan_day * DAY_SECONDS;
           save_acct.created_at                  = now;
@@ -356,7 +464,14 @@ using namespace wasm::safemath;
           }
           
           campaign.quotas_purchased += quantity.amount;
-          campaign.pledge_ntokens[extended_quantity.get_extended_nsymbol()].allocated_quotas += quantity.amount;
+          campaign.resume_release( now );
+          if (is_listed) {
+              camp_ntoken.quota.allocated_quotas += quantity.amount;
+              _db.set( campaign_id, camp_ntoken );
+          } else {
+              camp_parent.quota.allocated_quotas += quantity.amount;
+              _db.set( camp_parent );
+          }
           _db.set( campaign );
       } else {
           CHECKC( false, err::PARAM_ERROR, "param error" );
@@ -397,9 +512,12 @@ using namespace wasm::safemath;
           int64_t nft_supply = ntoken::get_supply(ntoken_contract, extended_nsymbol_tmp.get_nsymbol());
           CHECKC( nft_supply>0, err::RECORD_NOT_FOUND, "nft not found: " + to_string(nftids[i]) )
           
-          if (campaign.pledge_ntokens.count(extended_nsymbol_tmp)) 
+          campaign_ntoken_t camp_ntoken(extended_nsymbol_tmp);
+          if (_db.get( campaign.id, camp_ntoken )) {
+              CHECKC( camp_ntoken.symbol == extended_nsymbol_tmp, err::PARAM_ERROR, "nft id already pledged from another contract: " + to_string(nftids[i]) )
               continue;
-          campaign.pledge_ntokens.insert({extended_nsymbol_tmp, quotas()});
+          }
+          _db.set( campaign.id, camp_ntoken, false );
       }
               
       CHECKC( plan_day > 0, err::PARAM_ERROR, "plan days must be greater than 0" )      
@@ -408,10 +526,88 @@ using namespace wasm::safemath;
       campaign.plan_day         = plan_day;
       campaign.plan_interest    = plan_interest;
       campaign.total_quotas     = total_quotas;
-      campaign.campaign_name_cn = campaign_name_cn;
-      campaign.campaign_name_en = campaign_name_en;
-      campaign.campaign_pic_url_cn = campaign_pic_url_cn;
-      campaign.campaign_pic_url_en = campaign_pic_url_en;
+
+      campaign_meta_t meta(campaign.id);
+      meta.campaign_name_cn     = campaign_name_cn;
+      meta.campaign_name_en     = campaign_name_en;
+      meta.campaign_pic_url_cn  = campaign_pic_url_cn;
+      meta.campaign_pic_url_en  = campaign_pic_url_en;
+      _db.set( meta );
+  }
+
+  // move position to new_owner scope, keeping its id, accumulator snapshot and collected interest
+  void amaxnft_mine::_change_acct( const name& owner, const name& new_owner, const save_account_t& save_acct )
+  {
+      save_account_t new_save_acct(save_acct.id);
+      new_save_acct.campaign_id                 = save_acct.campaign_id;
+      new_save_acct.pledged                     = save_acct.pledged;
+      new_save_acct.save_pre_interest           = save_acct.save_pre_interest;
+      new_save_acct.interest_collected          = save_acct.interest_collected;
+      new_save_acct.term_ended_at               = save_acct.term_ended_at;
+      new_save_acct.last_collected_at           = save_acct.last_collected_at;
+      new_save_acct.created_at                  = save_acct.created_at;
+      new_save_acct.save_pre_interest_acc.emplace( save_acct.get_save_pre_interest() );
+
+      _db.set( new_owner.value, new_save_acct, false);
+      _db.del( owner.value, save_acct );
+  }
+
+  bool amaxnft_mine::_get_campaign( save_campaign_t &campaign )
+  {
+      if ( _db.get( campaign ) ) {
+          campaign.release_interest( time_point_sec(current_time_point()) );
+          return true;
+      }
+
+      save_campaign_v1_t legacy(campaign.id);
+      if ( !_db.get( legacy ) ) return false;
+
+      campaign.sponsor            = legacy.sponsor;
+      campaign.interest_symbol    = legacy.interest_symbol;
+      campaign.plan_day           = legacy.plan_day;
+      campaign.plan_interest      = legacy.plan_interest;
+      campaign.total_quotas       = legacy.total_quotas;
+      campaign.quotas_purchased   = legacy.quotas_purchased;
+      campaign.interest_total     = legacy.interest_total;
+      campaign.interest_collected = legacy.interest_collected;
+      campaign.pre_interest_acc   = legacy.get_pre_interest();
+      campaign.pre_interest_rem   = legacy.pre_interest_rem.value_or(0);
+      campaign.status             = legacy.status;
+      campaign.begin_at           = legacy.begin_at;
+      campaign.end_at             = legacy.end_at;
+      campaign.created_at         = legacy.created_at;
+      _db.set( campaign );
+
+      campaign_meta_t meta(campaign.id);
+      meta.campaign_name_cn       = legacy.campaign_name_cn;
+      meta.campaign_name_en       = legacy.campaign_name_en;
+      meta.campaign_pic_url_cn    = legacy.campaign_pic_url_cn;
+      meta.campaign_pic_url_en    = legacy.campaign_pic_url_en;
+      _db.set( meta );
+
+      for (const auto& [sym, quota] : legacy.pledge_ntokens) {
+          // rows are keyed by nsymbol only, an nft id listed from two contracts keeps its first listing
+          campaign_ntoken_t camp_ntoken(sym);
+          if ( _db.get( campaign.id, camp_ntoken ) ) continue;
+          camp_ntoken.quota = quota;
+          _db.set( campaign.id, camp_ntoken, false );
+      }
+      _db.del( legacy );
+      return true;
+  }
+
+  void amaxnft_mine::_del_campaign( const save_campaign_t &campaign )
+  {
+      campaign_ntoken_t::tbl_t ntokens(_self, campaign.id);
+      for (auto itr = ntokens.begin(); itr != ntokens.end(); ) {
+          itr = ntokens.erase(itr);
+      }
+
+      campaign_meta_t meta(campaign.id);
+      if ( _db.get( meta ) ) _db.del( meta );
+      campaign_parent_t camp_parent(campaign.id);
+      if ( _db.get( camp_parent ) ) _db.del( camp_parent );
+      _db.del( campaign );
   }
 
   void amaxnft_mine::_int_coll_log(const name& account, const uint64_t& account_id, const uint64_t& campaign_id, const asset &quantity, const time_point& created_at) {
@@ -30,6 +30,7 @@ using namespace eosio;
 static constexpr uint64_t  DAY_SECONDS = 24 * 60 * 60;
 static constexpr uint64_t  YEAR_SECONDS = 365 * 24 * 60 * 60;
 static constexpr uint64_t  YEAR_DAYS   = 365;
+static constexpr uint64_t  BATCH_SAVE_ID = UINT64_MAX;     //intcolllog account_id of logs summed over save accounts
 
 namespace campaign_status {
     static constexpr eosio::name INIT               = "init"_n;
@@ -57,6 +58,26 @@ GLOBAL_TBL("global") global_t {
 
 typedef eosio::singleton< "global"_n, global_t > global_singleton;
 
+GLOBAL_TBL("gccursor") gc_cursor_t {
+    uint64_t        next_cursor             = 0;    //next campaign id + 1 to resume gc from, 0: pass finished
+    uint32_t        deleted_count           = 0;    //campaigns deleted by the last gc
+    time_point_sec  collected_at;
+
+    EOSLIB_SERIALIZE( gc_cursor_t, (next_cursor)(deleted_count)(collected_at) )
+};
+
+typedef eosio::singleton< "gccursor"_n, gc_cursor_t > gc_cursor_singleton;
+
+//scope: owner
+GLOBAL_TBL("claimcursor") claim_cursor_t {
+    uint64_t        next_cursor             = 0;    //save id to resume claimall from, 0: pass finished
+    time_point_sec  claimed_at;
+
+    EOSLIB_SERIALIZE( claim_cursor_t, (next_cursor)(claimed_at) )
+};
+
+typedef eosio::singleton< "claimcursor"_n, claim_cursor_t > claim_cursor_singleton;
+
 
 struct quotas {
     uint32_t                           allocated_quotas;
@@ -66,7 +87,8 @@ struct quotas {
 };
 
 //scope: self
-SAVE_TBL save_campaign_t {
+//Note: legacy row, converted into save_campaign_t and its child rows by migratecamp or upon first touch
+SAVE_TBL save_campaign_v1_t {
     uint64_t                          id;
     name                              sponsor;                     
     string                            campaign_name_cn;                
@@ -84,6 +106,41 @@ SAVE_TBL save_campaign_t {
     time_point_sec                    begin_at;             
     time_point_sec                    end_at;               
     time_point_sec                    created_at;    
+    save_campaign_v1_t() {}
+    save_campaign_v1_t(const uint64_t& i): id(i) {}
+
+    uint64_t primary_key()const { return id; }
+    uint64_t scope()const { return 0; }
+
+    typedef multi_index<"savecampaign"_n, save_campaign_v1_t > tbl_t;
+
+    EOSLIB_SERIALIZE( save_campaign_v1_t,  (id)(sponsor)(campaign_name_cn)
+                                    (campaign_name_en)(campaign_pic_url)
+                                    (pledge_ntokens)(interest_symbol)(plans)
+                                    (total_quotas)(quotas_purchased)(interest_total)
+                                    (interest_alloted)(interest_collected)(status) 
+                                    (begin_at)(end_at)(created_at) )
+
+};
+
+//scope: self
+//Note: pledge ntokens and plans are kept in campaign_ntoken_t and campaign_plan_t,
+//      display strings in campaign_meta_t
+SAVE_TBL save_campaign_t {
+    uint64_t                          id;
+    name                              sponsor;                     
+    extended_symbol                   interest_symbol;
+    uint8_t                           ntoken_count = 0;            //rows in campaign_ntoken_t
+    uint8_t                           plan_count = 0;              //rows in campaign_plan_t
+    uint32_t                          total_quotas;
+    uint32_t                          quotas_purchased = 0;
+    asset                             interest_total;              //prestore total interest
+    asset                             interest_alloted;            //account total interest
+    asset                             interest_collected;
+    name                              status;                     //campaign status (1)init : fee paid； (2)created : interest transferred
+    time_point_sec                    begin_at;             
+    time_point_sec                    end_at;               
+    time_point_sec                    created_at;    
     save_campaign_t() {}
     save_campaign_t(const uint64_t& i): id(i) {}
 
@@ -94,17 +151,70 @@ SAVE_TBL save_campaign_t {
     asset    calc_available_interest()const { return interest_total - interest_collected; }
     asset    calc_refund_interest()   const { return interest_total - interest_alloted; }
 
-    typedef multi_index<"savecampaign"_n, save_campaign_t > tbl_t;
+    uint128_t by_status_end()const { return (uint128_t)status.value << 64 | (uint128_t)end_at.sec_since_epoch() << 32 | (id & 0x00000000FFFFFFFF); }
 
-    EOSLIB_SERIALIZE( save_campaign_t,  (id)(sponsor)(campaign_name_cn)
-                                    (campaign_name_en)(campaign_pic_url)
-                                    (pledge_ntokens)(interest_symbol)(plans)
+    typedef multi_index<"campaigns"_n, save_campaign_t,
+        indexed_by<"statusend"_n, const_mem_fun<save_campaign_t, uint128_t, &save_campaign_t::by_status_end> >
+    > tbl_t;
+
+    EOSLIB_SERIALIZE( save_campaign_t,  (id)(sponsor)
+                                    (interest_symbol)(ntoken_count)(plan_count)
                                     (total_quotas)(quotas_purchased)(interest_total)
                                     (interest_alloted)(interest_collected)(status) 
                                     (begin_at)(end_at)(created_at) )
 
 };
 
+//scope: self
+//Note: written only by setcampaign, never read by contract actions
+SAVE_TBL campaign_meta_t {
+    uint64_t                          campaign_id;                 //PK, same as save_campaign_t
+    string                            campaign_name_cn;                
+    string                            campaign_name_en;            //campaign english name
+    string                            campaign_pic_url;            //campaign picture
+
+    campaign_meta_t() {}
+    campaign_meta_t(const uint64_t& i): campaign_id(i) {}
+
+    uint64_t primary_key()const { return campaign_id; }
+    uint64_t scope()const { return 0; }
+
+    typedef multi_index<"campmeta"_n, campaign_meta_t > tbl_t;
+
+    EOSLIB_SERIALIZE( campaign_meta_t, (campaign_id)(campaign_name_cn)(campaign_name_en)(campaign_pic_url) )
+};
+
+//scope: campaign_id
+SAVE_TBL campaign_ntoken_t {
+    extended_nsymbol                  symbol;                      //pledge ntoken
+    uint32_t                          allocated_quotas = 0;
+    uint32_t                          redeemed_quotas  = 0;
+
+    campaign_ntoken_t() {}
+    campaign_ntoken_t(const extended_nsymbol& s): symbol(s) {}
+
+    uint64_t primary_key()const { return symbol.get_nsymbol().raw(); }
+
+    typedef multi_index<"campntokens"_n, campaign_ntoken_t > tbl_t;
+
+    EOSLIB_SERIALIZE( campaign_ntoken_t, (symbol)(allocated_quotas)(redeemed_quotas) )
+};
+
+//scope: campaign_id
+SAVE_TBL campaign_plan_t {
+    uint16_t                          days;                        //PK
+    asset                             profit;                      //interest per quota per day
+
+    campaign_plan_t() {}
+    campaign_plan_t(const uint16_t& d): days(d) {}
+
+    uint64_t primary_key()const { return days; }
+
+    typedef multi_index<"campplans"_n, campaign_plan_t > tbl_t;
+
+    EOSLIB_SERIALIZE( campaign_plan_t, (days)(profit) )
+};
+
 //Scope: account
 //Note: record will be deleted upon withdrawal/redemption
 SAVE_TBL save_account_t {
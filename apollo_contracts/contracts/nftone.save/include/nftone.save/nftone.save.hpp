@@ -105,6 +105,20 @@ class [[eosio::contract("nftone.save")]] nftone_save : public contract {
   */
   ACTION redeem(const name& issuer, const name& owner, const uint64_t& save_id);
   
+  /**
+  * @brief user claim due interest and redeem matured nfts of all save accounts
+  *
+  * @param owner  users participating in the campaign.
+  * @param cursor  save id to start from.
+  * @param max_rows  max save accounts to scan in this action, whether or not anything is due;
+  *                  the save id to resume from is recorded in claimcursor of the owner, 0 once finished.
+  *
+  * interest is summed into one transfer per token, nfts into one transfer per ntoken contract,
+  * and one intcolllog with account_id BATCH_SAVE_ID is sent per campaign.
+  * accounts of a missing campaign, or of a campaign short of interest, are skipped.
+  */
+  ACTION claimall(const name& owner, const uint64_t& cursor, const uint32_t& max_rows);
+  
   /**
   * @brief sponsor cancel campaign
   *
@@ -118,6 +132,23 @@ class [[eosio::contract("nftone.save")]] nftone_save : public contract {
   
   ACTION delcampaign(const vector<uint64_t>& campaign_ids);
   
+  /**
+  * @brief delete refunded campaigns whose positions are all redeemed
+  *
+  * @param cursor  campaign id + 1 to resume from, 0 to start from the earliest end time;
+  *                the next cursor is recorded in gccursor, 0 once the pass is finished.
+  * @param max_rows  max campaigns to check in this action.
+  */
+  ACTION gc(const uint64_t& cursor, const uint32_t& max_rows);
+  
+  /**
+  * @brief move legacy campaigns and their pledge ntokens and plans into the split tables,
+  *        legacy campaigns are also converted upon first touch
+  *
+  * @param campaign_ids  legacy campaign ids.
+  */
+  ACTION migratecamp(const vector<uint64_t>& campaign_ids);
+  
   ACTION intcolllog(const name& account, const uint64_t& account_id, const uint64_t& campaign_id, const asset &quantity, const time_point& created_at);
   using interest_collect_log_action = eosio::action_wrapper<"intcolllog"_n, &nftone_save::intcolllog>; 
 
@@ -160,6 +191,18 @@ class [[eosio::contract("nftone.save")]] nftone_save : public contract {
                           const string_view &campaign_name_en,
                           const string_view &campaign_pic_url );
                                                                                                   
+      bool _get_campaign( save_campaign_t& campaign );
+
+      bool _migrate_campaign( const uint64_t& campaign_id );
+
+      void _del_campaign( const save_campaign_t& campaign );
+
+      void _del_campaign_rows( const uint64_t& campaign_id );
+
+      void _add_redeemed_quotas( const uint64_t& campaign_id, const extended_nasset& pledged );
+
+      bool _is_fully_redeemed( const uint64_t& campaign_id );
+                                                                                                  
       void _int_coll_log(const name& account, const uint64_t& account_id, const uint64_t& campaign_id, const asset &quantity, const time_point& created_at);
       
 };
@@ -73,7 +73,7 @@ using namespace wasm::safemath;
       require_auth(sponsor);
       
       save_campaign_t campaign(campaign_id);
-      CHECKC( _db.get( campaign ), err::RECORD_NOT_FOUND, "campaign not found: " + to_string( campaign_id ) )
+      CHECKC( _get_campaign( campaign ), err::RECORD_NOT_FOUND, "campaign not found: " + to_string( campaign_id ) )
       CHECKC( campaign.sponsor == sponsor, err::NO_AUTH, "permission denied" )
       
       CHECKC( campaign.interest_total.to_string().length() != 0, save_err::INTEREST_INSUFFICIENT, "interest not transferred" )
@@ -88,8 +88,8 @@ using namespace wasm::safemath;
           CHECKC( end_at > current_time_point().sec_since_epoch(), err::PARAM_ERROR, "begin time should be less than end time");
       }
       
-      CHECKC( nftids.size() + campaign.pledge_ntokens.size() <= _gstate.nft_size_limit, err::PARAM_ERROR, "nft size should be less than or equal to 5");
-      CHECKC( plan_days_list.size() + campaign.plans.size() <= _gstate.plan_size_limit, err::PARAM_ERROR, "plan size should be less than or equal to 5");
+      CHECKC( nftids.size() + campaign.ntoken_count <= _gstate.nft_size_limit, err::PARAM_ERROR, "nft size should be less than or equal to 5");
+      CHECKC( plan_days_list.size() + campaign.plan_count <= _gstate.plan_size_limit, err::PARAM_ERROR, "plan size should be less than or equal to 5");
       CHECKC( plan_days_list.size() == plan_profits_list.size(), err::PARAM_ERROR, "days and profit_tokens size mismatch" );
       CHECKC( _gstate.nft_contracts.count(ntoken_contract), err::PARAM_ERROR, "ntoken contract invalid" )
       CHECKC( campaign_name_cn.size() <= 64 && campaign_name_cn.size() > 0, err::MEMO_FORMAT_ERROR, "campaign_name_cn length is not more than 108 bytes and not empty");
@@ -123,7 +123,7 @@ using namespace wasm::safemath;
       CHECKC( elapsed_sec > DAY_SECONDS, save_err::TIME_PREMATURE, "less than 24 hours since last interest collection time" )
       
       save_campaign_t campaign( save_acct.campaign_id );
-      CHECKC( _db.get( campaign ), err::RECORD_NOT_FOUND, "campaign not found: " + to_string( save_acct.campaign_id ) )
+      CHECKC( _get_campaign( campaign ), err::RECORD_NOT_FOUND, "campaign not found: " + to_string( save_acct.campaign_id ) )
 
       auto interest_due = save_acct.calc_due_interest();
       CHECKC( interest_due.amount > 0, err::NOT_POSITIVE, "interest due amount is zero" )
@@ -152,13 +152,13 @@ using namespace wasm::safemath;
       CHECKC( _db.get( owner.value, save_acct ), err::RECORD_NOT_FOUND, "account save not found" )
 
       auto campaign = save_campaign_t( save_acct.campaign_id );
-      CHECKC( _db.get( campaign ), err::RECORD_NOT_FOUND, "plan not found: " + to_string(save_acct.campaign_id) )
+      CHECKC( _get_campaign( campaign ), err::RECORD_NOT_FOUND, "plan not found: " + to_string(save_acct.campaign_id) )
 
       CHECKC( save_acct.term_ended_at < current_time_point(), save_err::TERM_NOT_ENDED, "term not ended" )
       CHECKC( save_acct.term_ended_at <= save_acct.last_collected_at, save_err::INTEREST_NOT_COLLECTED, "interest not collected" )
       auto pledged_quant = save_acct.pledged;
-      campaign.pledge_ntokens[pledged_quant.get_extended_nsymbol()].redeemed_quotas   += pledged_quant.quantity.amount;
-      _db.set( campaign );
+
+      _add_redeemed_quotas( save_acct.campaign_id, pledged_quant );
       _db.del( owner.value, save_acct );
       
       vector<nasset> redeem_quant = {pledged_quant.quantity};
@@ -166,6 +166,98 @@ using namespace wasm::safemath;
       
   }
 
+  void nftone_save::claimall(const name& owner, const uint64_t& cursor, const uint32_t& max_rows) {
+      require_auth( owner );
+      CHECKC( max_rows > 0, err::PARAM_ERROR, "max_rows must be greater than 0" )
+
+      auto now = current_time_point();
+      map<uint64_t, save_campaign_t>    campaigns;
+      set<uint64_t>                     missing_campaigns;      //campaigns not found, their positions are skipped
+      map<uint64_t, asset>              campaign_interests;     //interest collected per campaign
+      map<extended_symbol, asset>       interests;              //interest to transfer per token
+      map<name, map<uint64_t, nasset>>  redeem_ntokens;         //ntokens to return per contract, keyed by nsymbol raw
+
+      save_account_t::tbl_t save_accts(_self, owner.value);
+      auto itr = save_accts.lower_bound( cursor );
+      //every scanned row counts toward max_rows, so the scan stays bounded
+      for (uint32_t rows = 0; itr != save_accts.end() && rows < max_rows; rows++) {
+          auto campaign_itr = campaigns.find( itr->campaign_id );
+          if (campaign_itr == campaigns.end()) {
+              save_campaign_t campaign( itr->campaign_id );
+              if (missing_campaigns.count( campaign.id ) || !_get_campaign( campaign )) {
+                  missing_campaigns.insert( campaign.id );
+                  itr++;
+                  continue;
+              }
+              campaign_itr = campaigns.emplace( campaign.id, campaign ).first;
+          }
+          auto& campaign = campaign_itr->second;
+
+          auto interest_due = itr->last_collected_at < itr->term_ended_at ? itr->calc_due_interest() : asset(0, itr->interest_alloted.symbol);
+          //a campaign short of interest leaves the position for a later call
+          if (interest_due.amount > 0 && campaign.calc_available_interest() < interest_due) {
+              itr++;
+              continue;
+          }
+          if (interest_due.amount > 0) {
+              campaign.interest_collected += interest_due;
+
+              if (campaign_interests.count( campaign.id ))
+                  campaign_interests[campaign.id] += interest_due;
+              else
+                  campaign_interests[campaign.id] = interest_due;
+
+              if (interests.count( campaign.interest_symbol ))
+                  interests[campaign.interest_symbol] += interest_due;
+              else
+                  interests[campaign.interest_symbol] = interest_due;
+
+              save_accts.modify( itr, same_payer, [&]( auto& a ) {
+                  a.interest_collected  += interest_due;
+                  a.last_collected_at    = now;
+              });
+          }
+
+          auto matured = itr->term_ended_at < now && itr->term_ended_at <= itr->last_collected_at;
+          if (matured) {
+              auto pledged_quant = itr->pledged;
+              _add_redeemed_quotas( itr->campaign_id, pledged_quant );
+
+              auto& ntokens = redeem_ntokens[pledged_quant.contract];
+              auto nasset_itr = ntokens.find( pledged_quant.quantity.symbol.raw() );
+              if (nasset_itr == ntokens.end())
+                  ntokens.emplace( pledged_quant.quantity.symbol.raw(), pledged_quant.quantity );
+              else
+                  nasset_itr->second += pledged_quant.quantity;
+
+              itr = save_accts.erase( itr );
+          } else {
+              itr++;
+          }
+      }
+
+      claim_cursor_singleton claim_cursor(_self, owner.value);
+      auto claim_state = claim_cursor.get_or_default();
+      claim_state.next_cursor   = itr != save_accts.end() ? itr->id : 0;
+      claim_state.claimed_at    = now;
+      claim_cursor.set( claim_state, owner );
+
+      for (auto& [campaign_id, campaign_interest] : campaign_interests) {
+          _db.set( campaigns[campaign_id] );
+          _int_coll_log(owner, BATCH_SAVE_ID, campaign_id, campaign_interest, now);
+      }
+
+      for (auto& [interest_symbol, interest] : interests) {
+          TRANSFER( interest_symbol.get_contract(), owner, interest, "interest: claim all" )
+      }
+
+      for (auto& [ntoken_contract, ntokens] : redeem_ntokens) {
+          vector<nasset> redeem_quants;
+          for (auto& [raw, quantity] : ntokens) redeem_quants.push_back( quantity );
+          NTOKEN_TRANSFER( ntoken_contract, owner, redeem_quants, "redeem: claim all" )
+      }
+  }
+
   void nftone_save::cancelcamp(const name& issuer, const name& owner, const uint64_t& campaign_id) {
       require_auth( issuer );
       if ( issuer != owner ) {
@@ -173,13 +265,13 @@ using namespace wasm::safemath;
       }
       
       save_campaign_t campaign(campaign_id);
-      CHECKC( _db.get( campaign ), err::RECORD_NOT_FOUND, "campaign not found: " + to_string( campaign_id ) )
+      CHECKC( _get_campaign( campaign ), err::RECORD_NOT_FOUND, "campaign not found: " + to_string( campaign_id ) )
       CHECKC( campaign.status == campaign_status::CREATED, err::STATE_MISMATCH, "status mismatch" )
       CHECKC( campaign.sponsor == owner, err::NO_AUTH, "permission denied" )
       CHECKC( campaign.begin_at > current_time_point(), save_err::STARTED, "campaign already started" )
       TRANSFER( campaign.interest_symbol.get_contract(), owner, campaign.interest_total, "cancel campaign: " + to_string(campaign_id) )
       
-      _db.del( campaign );
+      _del_campaign( campaign );
   }
   
   void nftone_save::refundint(const name& issuer, const name& owner, const uint64_t& campaign_id) {
@@ -189,7 +281,7 @@ using namespace wasm::safemath;
       }
       
       save_campaign_t campaign(campaign_id);
-      CHECKC( _db.get( campaign ), err::RECORD_NOT_FOUND, "campaign not found: " + to_string( campaign_id ) )
+      CHECKC( _get_campaign( campaign ), err::RECORD_NOT_FOUND, "campaign not found: " + to_string( campaign_id ) )
       CHECKC( campaign.sponsor == owner, err::NO_AUTH, "permission denied" )
       CHECKC( campaign.end_at < current_time_point(), save_err::NOT_ENDED, "campaign not ended" )
       
@@ -207,12 +299,54 @@ using namespace wasm::safemath;
       save_campaign_t campaign;
       for (int i = 0; i < campaign_ids.size(); i++) {
           campaign = save_campaign_t(campaign_ids[i]);
-          if(!_db.get( campaign )) continue;
+          if(!_get_campaign( campaign )) continue;
           if(campaign.status != campaign_status::REFUNDED) continue;
-          _db.del(campaign);
+          _del_campaign(campaign);
       }
   }
   
+  void nftone_save::gc(const uint64_t& cursor, const uint32_t& max_rows) {
+      require_auth(_gstate.admin);
+      CHECKC( max_rows > 0, err::PARAM_ERROR, "max_rows must be greater than 0" )
+
+      save_campaign_t::tbl_t campaigns(_self, _self.value);
+      auto status_idx = campaigns.get_index<"statusend"_n>();
+
+      //cursor is the campaign id + 1 to resume from, 0 starts over
+      uint128_t lower = (uint128_t)campaign_status::REFUNDED.value << 64;
+      if (cursor > 0) {
+          auto cursor_itr = campaigns.find( cursor - 1 );
+          if (cursor_itr != campaigns.end() && cursor_itr->status == campaign_status::REFUNDED)
+              lower = cursor_itr->by_status_end();
+      }
+
+      uint32_t deleted = 0;
+      auto itr = status_idx.lower_bound( lower );
+      for (uint32_t rows = 0; itr != status_idx.end() && itr->status == campaign_status::REFUNDED && rows < max_rows; rows++) {
+          if (!_is_fully_redeemed( itr->id )) {
+              itr++;
+              continue;
+          }
+          _del_campaign_rows( itr->id );
+          itr = status_idx.erase( itr );
+          deleted++;
+      }
+
+      gc_cursor_singleton gc_cursor(_self, _self.value);
+      auto gc_state = gc_cursor.get_or_default();
+      gc_state.next_cursor       = (itr != status_idx.end() && itr->status == campaign_status::REFUNDED) ? itr->id + 1 : 0;
+      gc_state.deleted_count     = deleted;
+      gc_state.collected_at      = current_time_point();
+      gc_cursor.set( gc_state, _self );
+  }
+
+  void nftone_save::migratecamp(const vector<uint64_t>& campaign_ids) {
+      require_auth(_gstate.admin);
+      for (auto& campaign_id : campaign_ids) {
+          _migrate_campaign( campaign_id );
+      }
+  }
+
   void nftone_save::intcolllog(const name& account, const uint64_t& account_id, const uint64_t& plan_id, const asset &quantity, const time_point& created_at) {
       require_auth(get_self());
       require_recipient(account);
@@ -222,7 +356,7 @@ using namespace wasm::safemath;
       require_auth(sponsor);
       
       save_campaign_t campaign(campaign_id);
-      CHECKC( _db.get( campaign ), err::RECORD_NOT_FOUND, "campaign not found: " + to_string( campaign_id ) )
+      CHECKC( _get_campaign( campaign ), err::RECORD_NOT_FOUND, "campaign not found: " + to_string( campaign_id ) )
       CHECKC( campaign.sponsor == sponsor, err::NO_AUTH, "permission denied" )
       CHECKC( campaign.interest_total.to_string().length() != 0, save_err::INTEREST_INSUFFICIENT, "interest not transferred" )
     
@@ -271,7 +405,7 @@ using namespace wasm::safemath;
 
           uint64_t campaign_id = to_uint64(parts[1], "campaign_id parse int error");
           save_campaign_t campaign(campaign_id);
-          CHECKC( _db.get( campaign ), err::RECORD_NOT_FOUND, "campaign not found: " + to_string( campaign_id ) )
+          CHECKC( _get_campaign( campaign ), err::RECORD_NOT_FOUND, "campaign not found: " + to_string( campaign_id ) )
           CHECKC( campaign.sponsor == from, err::NO_AUTH, "permission denied" )
           
           if (campaign.status == campaign_status::INIT) {
@@ -297,6 +431,7 @@ using namespace wasm::safemath;
   * @param quantity
   * @param memo: one formats:
   *       1) pledge : $campaign_id : $days                             -- gain interest by pledge ntoken 
+  *          each nasset in the transfer creates its own save account
   */  
   void nftone_save::_on_ntoken_transfer( const name& from,
                                               const name& to,
@@ -309,36 +444,48 @@ using namespace wasm::safemath;
       
       if (parts.size() == 3 && parts[0] == "pledge") {
         
-          nasset quantity = assets[0];
           auto now = time_point_sec(current_time_point());
-          extended_nasset extended_quantity = extended_nasset(quantity, get_first_receiver());
           auto campaign_id = to_uint64(parts[1], "campaign_id parse uint error");
           auto days        = to_uint64(parts[2], "days parse uint error");
           
           save_campaign_t campaign(campaign_id);
-          CHECKC( _db.get( campaign ), err::RECORD_NOT_FOUND, "campaign not found: " + to_string( campaign_id ) )
+          CHECKC( _get_campaign( campaign ), err::RECORD_NOT_FOUND, "campaign not found: " + to_string( campaign_id ) )
           CHECKC( campaign.status == campaign_status::CREATED, err::STATE_MISMATCH, "state mismatch" )
           CHECKC( campaign.end_at >= now, save_err::ENDED, "the campaign already ended" )
           CHECKC( campaign.begin_at <= now, save_err::NOT_START, "the campaign not start" )
-          CHECKC( campaign.plans.count(days), err::PARAM_ERROR, "this plan does not exist" )
-          CHECKC( quantity.amount <= campaign.calc_available_quotas(), save_err::QUOTAS_INSUFFICIENT, "quotas insufficient" )
-          CHECKC( campaign.pledge_ntokens.count(extended_quantity.get_extended_nsymbol()), err::PARAM_ERROR, "this ntoken does not exist" )
-          
-          auto sid = _gstate.last_save_id++;
-          save_account_t save_acct(sid);
-          save_acct.campaign_id                 = campaign_id;
-          save_acct.pledged                     = extended_quantity;
-          save_acct.plan_term_days              = days;
-          save_acct.interest_alloted            = campaign.plans[days] * days * quantity.amount;
-          save_acct.interest_collected          = asset(0, campaign.interest_symbol.get_symbol());
-          save_acct.term_ended_at               = now + days * DAY_SECONDS;
-          save_acct.created_at                  = now;
-          save_acct.last_collected_at           = now;
-          _db.set( from.value, save_acct, false );
+          campaign_plan_t plan(days);
+          CHECKC( _db.get( campaign_id, plan ), err::PARAM_ERROR, "this plan does not exist" )
+          CHECKC( assets.size() > 0, err::PARAM_ERROR, "no ntoken pledged" )
           
-          campaign.interest_alloted  += asset(quantity.amount * days * campaign.plans[days].amount, campaign.interest_symbol.get_symbol());
-          campaign.quotas_purchased += quantity.amount;
-          campaign.pledge_ntokens[extended_quantity.get_extended_nsymbol()].allocated_quotas += quantity.amount;
+          auto plan_profit = plan.profit;
+          campaign_ntoken_t::tbl_t campaign_ntokens(_self, campaign_id);
+          for (auto& quantity : assets) {
+              extended_nasset extended_quantity = extended_nasset(quantity, get_first_receiver());
+              CHECKC( quantity.amount > 0, err::NOT_POSITIVE, "ntoken amount must be positive" )
+              CHECKC( quantity.amount <= campaign.calc_available_quotas(), save_err::QUOTAS_INSUFFICIENT, "quotas insufficient" )
+              
+              auto pledge_itr = campaign_ntokens.find(quantity.symbol.raw());
+              CHECKC( pledge_itr != campaign_ntokens.end() && pledge_itr->symbol == extended_quantity.get_extended_nsymbol(), 
+                      err::PARAM_ERROR, "this ntoken does not exist" )
+              
+              auto sid = _gstate.last_save_id++;
+              save_account_t save_acct(sid);
+              save_acct.campaign_id                 = campaign_id;
+              save_acct.pledged                     = extended_quantity;
+              save_acct.plan_term_days              = days;
+              save_acct.interest_alloted            = plan_profit * days * quantity.amount;
+              save_acct.interest_collected          = asset(0, campaign.interest_symbol.get_symbol());
+              save_acct.term_ended_at               = now + days * DAY_SECONDS;
+              save_acct.created_at                  = now;
+              save_acct.last_collected_at           = now;
+              _db.set( from.value, save_acct, false );
+              
+              campaign.interest_alloted  += asset(quantity.amount * days * plan_profit.amount, campaign.interest_symbol.get_symbol());
+              campaign.quotas_purchased += quantity.amount;
+              campaign_ntokens.modify( pledge_itr, same_payer, [&]( auto& n ) {
+                  n.allocated_quotas += quantity.amount;
+              });
+          }
           _db.set( campaign );
       } else {
           CHECKC( false, err::PARAM_ERROR, "param error" );
@@ -373,6 +520,7 @@ using namespace wasm::safemath;
                                     const string_view &campaign_pic_url)
   {
       extended_nsymbol extended_nsymbol_tmp;
+      campaign_ntoken_t::tbl_t campaign_ntokens(_self, campaign.id);
       for (int i = 0; i < nftids.size(); i++) {
         
           extended_nsymbol_tmp = extended_nsymbol(nsymbol(nftids[i]), ntoken_contract);
@@ -380,14 +528,19 @@ using namespace wasm::safemath;
           int64_t nft_supply = ntoken::get_supply(ntoken_contract, extended_nsymbol_tmp.get_nsymbol());
           CHECKC( nft_supply>0, err::RECORD_NOT_FOUND, "nft not found: " + to_string(nftids[i]) )
           
-          if (campaign.pledge_ntokens.count(extended_nsymbol_tmp)) 
+          auto ntoken_itr = campaign_ntokens.find(extended_nsymbol_tmp.get_nsymbol().raw());
+          if (ntoken_itr != campaign_ntokens.end()) {
+              CHECKC( ntoken_itr->symbol == extended_nsymbol_tmp, err::PARAM_ERROR, "nft id already pledged from another contract: " + to_string(nftids[i]) )
               continue;
-          campaign.pledge_ntokens.insert({extended_nsymbol_tmp, quotas()});
+          }
+          campaign_ntokens.emplace( _self, [&]( auto& n ) { n = campaign_ntoken_t(extended_nsymbol_tmp); });
+          campaign.ntoken_count++;
       }
       
       asset interest_token(0, campaign.interest_symbol.get_symbol());
       uint64_t days = 0, max_days = 0;
       asset max_interest_token = interest_token;
+      campaign_plan_t::tbl_t campaign_plans(_self, campaign.id);
       for (int i = 0; i < plan_days_list.size(); i++) {
         
           days            = plan_days_list[i];
@@ -395,9 +548,13 @@ using namespace wasm::safemath;
           CHECKC( days > 0, err::PARAM_ERROR, "plan days must be greater than 0" )
           CHECKC( interest_token.amount > 0, err::PARAM_ERROR, "plan profit must be greater than 0" )
           
-          if(campaign.plans.count(days)) 
+          if(campaign_plans.find(days) != campaign_plans.end()) 
               continue;
-          campaign.plans.insert({days, interest_token});
+          campaign_plans.emplace( _self, [&]( auto& p ) {
+              p.days    = days;
+              p.profit  = interest_token;
+          });
+          campaign.plan_count++;
           
           if(interest_token > max_interest_token) max_interest_token = interest_token;
           if(days > max_days)                     max_days = days;
@@ -407,9 +564,109 @@ using namespace wasm::safemath;
       CHECKC( need_interest <= campaign.interest_total, save_err::INTEREST_INSUFFICIENT, "interest insufficient" )
       
       campaign.total_quotas     = total_quotas;
-      campaign.campaign_name_cn = campaign_name_cn;
-      campaign.campaign_name_en = campaign_name_en;
-      campaign.campaign_pic_url = campaign_pic_url;
+
+      campaign_meta_t meta(campaign.id);
+      meta.campaign_name_cn     = campaign_name_cn;
+      meta.campaign_name_en     = campaign_name_en;
+      meta.campaign_pic_url     = campaign_pic_url;
+      _db.set( meta );
+  }
+
+  bool nftone_save::_get_campaign( save_campaign_t& campaign )
+  {
+      if ( _db.get( campaign ) ) return true;
+      return _migrate_campaign( campaign.id ) && _db.get( campaign );
+  }
+
+  bool nftone_save::_migrate_campaign( const uint64_t& campaign_id )
+  {
+      save_campaign_v1_t legacy_campaign(campaign_id);
+      if(!_db.get( legacy_campaign )) return false;
+
+      save_campaign_t campaign(campaign_id);
+      campaign.sponsor            = legacy_campaign.sponsor;
+      campaign.interest_symbol    = legacy_campaign.interest_symbol;
+      campaign.plan_count         = legacy_campaign.plans.size();
+      campaign.total_quotas       = legacy_campaign.total_quotas;
+      campaign.quotas_purchased   = legacy_campaign.quotas_purchased;
+      campaign.interest_total     = legacy_campaign.interest_total;
+      campaign.interest_alloted   = legacy_campaign.interest_alloted;
+      campaign.interest_collected = legacy_campaign.interest_collected;
+      campaign.status             = legacy_campaign.status;
+      campaign.begin_at           = legacy_campaign.begin_at;
+      campaign.end_at             = legacy_campaign.end_at;
+      campaign.created_at         = legacy_campaign.created_at;
+
+      campaign_meta_t meta(campaign_id);
+      meta.campaign_name_cn       = legacy_campaign.campaign_name_cn;
+      meta.campaign_name_en       = legacy_campaign.campaign_name_en;
+      meta.campaign_pic_url       = legacy_campaign.campaign_pic_url;
+      _db.set( meta );
+
+      campaign_ntoken_t::tbl_t campaign_ntokens(_self, campaign_id);
+      for (auto& [symbol, quota] : legacy_campaign.pledge_ntokens) {
+          // rows are keyed by nsymbol only, an nft id listed from two contracts keeps its first listing
+          if (campaign_ntokens.find( symbol.get_nsymbol().raw() ) != campaign_ntokens.end()) continue;
+          campaign.ntoken_count++;
+          campaign_ntokens.emplace( _self, [&]( auto& n ) {
+              n.symbol            = symbol;
+              n.allocated_quotas  = quota.allocated_quotas;
+              n.redeemed_quotas   = quota.redeemed_quotas;
+          });
+      }
+
+      _db.set( campaign );
+
+      campaign_plan_t::tbl_t campaign_plans(_self, campaign_id);
+      for (auto& [days, profit] : legacy_campaign.plans) {
+          campaign_plans.emplace( _self, [&]( auto& p ) {
+              p.days    = days;
+              p.profit  = profit;
+          });
+      }
+
+      _db.del( legacy_campaign );
+      return true;
+  }
+
+  void nftone_save::_del_campaign( const save_campaign_t& campaign )
+  {
+      _del_campaign_rows( campaign.id );
+      _db.del( campaign );
+  }
+
+  void nftone_save::_del_campaign_rows( const uint64_t& campaign_id )
+  {
+      campaign_ntoken_t::tbl_t campaign_ntokens(_self, campaign_id);
+      for (auto itr = campaign_ntokens.begin(); itr != campaign_ntokens.end(); )
+          itr = campaign_ntokens.erase(itr);
+
+      campaign_plan_t::tbl_t campaign_plans(_self, campaign_id);
+      for (auto itr = campaign_plans.begin(); itr != campaign_plans.end(); )
+          itr = campaign_plans.erase(itr);
+
+      _db.del( campaign_meta_t(campaign_id) );
+  }
+
+  void nftone_save::_add_redeemed_quotas( const uint64_t& campaign_id, const extended_nasset& pledged )
+  {
+      // positions of a listing dropped as duplicate on conversion have no quota row left
+      campaign_ntoken_t::tbl_t campaign_ntokens(_self, campaign_id);
+      auto ntoken_itr = campaign_ntokens.find( pledged.quantity.symbol.raw() );
+      if (ntoken_itr == campaign_ntokens.end() || ntoken_itr->symbol != pledged.get_extended_nsymbol()) return;
+
+      campaign_ntokens.modify( ntoken_itr, same_payer, [&]( auto& n ) {
+          n.redeemed_quotas += pledged.quantity.amount;
+      });
+  }
+
+  bool nftone_save::_is_fully_redeemed( const uint64_t& campaign_id )
+  {
+      campaign_ntoken_t::tbl_t campaign_ntokens(_self, campaign_id);
+      for (auto itr = campaign_ntokens.begin(); itr != campaign_ntokens.end(); itr++) {
+          if (itr->redeemed_quotas < itr->allocated_quotas) return false;
+      }
+      return true;
   }
 
   void nftone_save::_int_coll_log(const name& account, const uint64_t& account_id, const uint64_t& campaign_id, const asset &quantity, const time_point& created_at) {
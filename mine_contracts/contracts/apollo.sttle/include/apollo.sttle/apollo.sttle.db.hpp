@@ -2,6 +2,7 @@
 
 #include <eosio/asset.hpp>
 #include <eosio/privileged.hpp>
+#include <eosio/singleton.hpp>
 #include <eosio/system.hpp>
 #include <eosio/time.hpp>
 
@@ -12,12 +13,12 @@
 #include <set>
 #include <type_traits>
 
+#define HASH256(str) sha256(const_cast<char*>(str.c_str()), str.size());
+
 #include "apollo.sttle/apollo.sttle.external.db.hpp"
 
 using namespace eosio;
 
-#define HASH256(str) sha256(const_cast<char*>(str.c_str()), str.size());
-
 #define SYMBOL(sym_code, precision) symbol(symbol_code(sym_code), precision)
 
 namespace apollo {
@@ -55,6 +56,17 @@ struct STTLE_TBL sttle_t {
     }
     uint64_t raw()const { return (uint64_t) token_id << 32 | sub_token_id; }
 
+    // UTC day index of the last settlement; a record never settled counts from the UTC day
+    // its sub_token_id day starts in, start_time_since_epoch is not day aligned
+    uint32_t last_settled_day()const {
+        if ( last_settled_at == time_point() ) return ( start_time_since_epoch + (uint64_t)sub_token_id * seconds_per_day ) / seconds_per_day;
+        return last_settled_at.sec_since_epoch() / seconds_per_day;
+    }
+
+    void set_last_settled_day( const uint32_t& day ) {
+        last_settled_at = time_point_sec( (uint64_t)day * seconds_per_day );
+    }
+
     // uint64_t    by_sub_token_id()const { return (uint64_t) sub_token_id << 32; }
 
     sttle_t() {}
@@ -68,4 +80,37 @@ struct STTLE_TBL sttle_t {
      EOSLIB_SERIALIZE( sttle_t, (pk_id)(owner)(beneficiary)(status)(last_settled_at)(token_id)(sub_token_id)(earning)(sttle_times) )
 };
 
+static uint128_t get_due_key( const name& status, const uint32_t& day, const uint64_t& pk_id ) {
+    return ( (uint128_t)status.value ) << 64 | (uint128_t)day << 32 | (pk_id & 0x00000000FFFFFFFF);
+
+}
+
+// due date index of sttle_t, kept in its own table so rows created before it are indexed by backfill
+struct STTLE_TBL sttle_due_t {
+    uint64_t       pk_id;               //sttle_t.pk_id
+    name           status;
+    uint32_t       last_settled_day;
+
+    uint64_t    primary_key()const { return pk_id; }
+    uint128_t   by_due()const { return get_due_key( status, last_settled_day, pk_id ); }
+
+    sttle_due_t() {}
+    sttle_due_t( const uint64_t& id ): pk_id(id){}
+    typedef eosio::multi_index
+            <"sttledue"_n, sttle_due_t,
+             indexed_by<"duedate"_n, const_mem_fun<sttle_due_t, uint128_t, &sttle_due_t::by_due> >
+     > idx_t;
+
+     EOSLIB_SERIALIZE( sttle_due_t, (pk_id)(status)(last_settled_day) )
+};
+
+struct [[eosio::table("crank"), eosio::contract("apollo.sttle")]] crank_t {
+    uint32_t       day = 0;             //day settled by the last crank
+    uint128_t      next_key = 0;        //resume cursor of duedate index, 0: done
+    uint32_t       settled_count = 0;   //records settled by the last crank
+
+    EOSLIB_SERIALIZE( crank_t, (day)(next_key)(settled_count) )
+};
+typedef eosio::singleton< "crank"_n, crank_t > crank_singleton;
+
 } // apollo
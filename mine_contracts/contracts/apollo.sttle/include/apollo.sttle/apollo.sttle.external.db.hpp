@@ -1,6 +1,8 @@
  #pragma once
 
 #include <eosio/asset.hpp>
+#include <eosio/binary_extension.hpp>
+#include <eosio/crypto.hpp>
 #include <eosio/privileged.hpp>
 #include <eosio/system.hpp>
 #include <eosio/time.hpp>
@@ -15,10 +17,6 @@
 using namespace eosio;
 
 
-static constexpr eosio::name APOLLO_TOKEN{"apollo.token"_n};
-static constexpr eosio::name AM_TOKEN{"cnyd.token"_n};
-static constexpr eosio::name APOLLO_EV{"apollo.ev"_n};
-
 namespace apollo {
 using namespace std;
 using namespace eosio;
@@ -127,18 +125,22 @@ struct tokenstats_t {
     name            creator;
     time_point_sec  created_at;
     bool            paused;
+    binary_extension<checksum256> invars_hash;  //computed once at create, read by tokeninvars index
 
     tokenstats_t() {};
     tokenstats_t(const uint64_t& id): token_id(id) {};
 
     uint64_t primary_key()const { return token_id; }
     uint64_t by_token_type()const { return (uint64_t) token_type; }
-    checksum256 by_token_invars()const { 
+    checksum256 calc_token_invars()const { 
         if (token_type == (uint8_t) token_type::POW)
             return std::get<pow_asset_invariables>(invars).hash(to_string(token_type)); 
         else 
             return checksum256();
     }
+    checksum256 by_token_invars()const { 
+        return invars_hash.has_value() ? invars_hash.value() : calc_token_invars();
+    }
     typedef eosio::multi_index
     < "tokenstats"_n,  tokenstats_t,
         indexed_by<"tokentypes"_n, const_mem_fun<tokenstats_t, uint64_t, &tokenstats_t::by_token_type> >,
@@ -146,7 +148,7 @@ struct tokenstats_t {
     > idx_t;
 
     EOSLIB_SERIALIZE(tokenstats_t,  (token_id)(token_type)(token_uri)(invars)(vars)(max_supply)(supply)
-                                    (creator)(created_at)(paused) )
+                                    (creator)(created_at)(paused)(invars_hash) )
 };
 
 
@@ -167,4 +169,17 @@ struct account_t {
 
 };
 
+//range walk of owner's balances of one token_id over all its sub_token_ids, returns the sum
+inline int64_t get_token_balances( const name& contract, const name& owner, const uint32_t& token_id, vector<token_asset>& balances ) {
+    account_t::idx_t accounts(contract, owner.value);
+    uint64_t upper = ((uint64_t) token_id + 1) << 32;
+
+    int64_t total = 0;
+    for (auto itr = accounts.lower_bound( (uint64_t) token_id << 32 ); itr != accounts.end() && itr->primary_key() < upper; itr++) {
+        total += itr->balance.amount;
+        balances.push_back( itr->balance );
+    }
+    return total;
+}
+
 } // apollo
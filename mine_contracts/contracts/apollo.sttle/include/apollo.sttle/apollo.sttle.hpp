@@ -55,7 +55,7 @@ static constexpr eosio::name AM_TOKEN{"aplink"_n};
 static constexpr symbol   AM_SYMBOL = symbol(symbol_code("APLINK"), 2);
 //
 
-class [[eosio::contract("apollo.sttle")]] sttle : public contract {
+class [[eosio::contract("apollo.sttle")]] sttlement : public contract {
 private:
     dbc        _db;
     dbc        _apollo_db;
@@ -64,23 +64,60 @@ private:
 public:
     using contract::contract;
 
-     sttle(eosio::name receiver, eosio::name code, datastream<const char*> ds):
-        _db(_self), _apollo_db(APOLLO_TOKEN), _am_db(AM_TOKEN), contract(receiver, code, ds), _global(_self, _self.value) {
+     sttlement(eosio::name receiver, eosio::name code, datastream<const char*> ds):
+        contract(receiver, code, ds), _db(_self), _apollo_db(APOLLO_TOKEN), _am_db(AM_TOKEN) {
      }
 
     [[eosio::action]]
     void startmine(const uint32_t& token_id, const name& owner, const name& beneficiary);
 
+    /**
+     * settle one day of a record; unlike the batch actions below it keeps paying
+     * after the token's service_life_days
+     */
     [[eosio::action]]
-    void settlement(const name& owner, const uint32_t& sub_token_id, const uinuint16_tt32_t& type );
+    void settlement(const name& owner, const uint64_t& id, const name& type);
 
+    /**
+     * settle all due START records of owner, at most max_rows settled records, with one electricity
+     * burn and one earning transfer; records past service_life_days, without balance or earning are skipped
+     */
     [[eosio::action]]
-    void pause(const name& owner, const uint32_t& sub_token_id);
+    void settleall(const name& owner, const uint32_t& max_rows);
 
+    /**
+     * catch up to max_days missed days of one record in one burn and one transfer,
+     * bounded by the record's remaining service life
+     */
     [[eosio::action]]
-    void destory(const uint32_t& sub_token_id);
+    void settledays(const uint64_t& id, const uint16_t& max_days);
+
+    /**
+     * settle due START records (last settled before day) in duedate order, at most max_rows,
+     * with one burn and one transfer per owner; the resume cursor is recorded in the crank table.
+     * records without balance or earning are skipped, records past their service life leave the index
+     */
+    [[eosio::action]]
+    void crank(const uint32_t& day, const uint128_t& cursor, const uint32_t& max_rows);
+
+    /**
+     * backfill the duedate index of records created before it
+     */
+    [[eosio::action]]
+    void indexdue(const uint64_t& cursor, const uint32_t& max_rows);
+
+    [[eosio::action]]
+    void pause(const name& owner, const uint64_t& id);
+
+    [[eosio::action]]
+    void destory(const name& owner, const uint64_t& id);
 
     [[eosio::action]]
     void start( const name& owner, const uint64_t& id );
+
+private:
+    void     _set_due( const sttle_t& sttle );
+    uint16_t _calc_settle_days( const sttle_t& sttle, const pow_asset_invariables& invariables, const uint16_t& days );
+    int64_t  _calc_earning( const int64_t& balance, const power_asset_variables& variables );
 };
 } //namespace apollo
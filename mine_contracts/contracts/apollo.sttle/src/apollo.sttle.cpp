@@ -31,7 +31,7 @@ ACTION sttlement::startmine( const uint32_t& token_id, const name& owner, const
     uint128_t sec_index =get_union_id( owner, token_id, sub_token_id );
     // check( sttle_index.find(sec_index) == sttle_index.end() , "sttlement already existing!" );
     if( sttle_index.find(sec_index) == sttle_index.end() ){
-        sttles.emplace( _self, [&]( auto& item ) {
+        auto sttle_itr = sttles.emplace( _self, [&]( auto& item ) {
                 item.pk_id              = sttles.available_primary_key(); if (item.pk_id == 0) item.pk_id = 1;
                 item.owner              = owner;
                 item.beneficiary        = beneficiary;
@@ -45,6 +45,7 @@ ACTION sttlement::startmine( const uint32_t& token_id, const name& owner, const
 
                 item.earning            = tokenasset;
             });
+        _set_due( *sttle_itr );
     };
 
 
@@ -58,10 +59,10 @@ ACTION sttlement::settlement( const name& owner, const uint64_t& id, const name&
     CHECK( _db.get( sttle ), err::RECORD_NOT_FOUND, "record not found: " + to_string(id));
 
     uint32_t cur_days = current_time_point().sec_since_epoch() / seconds_per_day;
-    uint32_t last_settled_days = sttle.last_settled_at.sec_since_epoch() / seconds_per_day;
+    uint32_t last_settled_day = sttle.last_settled_day();
     CHECK( sttle.status != sttle_status::PAUSE, err::PAUSED, "record is already paused");
     CHECK( sttle.status != sttle_status::DEL, err::RECORD_DEL, "record is already delete");
-    CHECK( last_settled_days < cur_days, err::RECORD_SETTLED, "record is settled: " + to_string(id));
+    CHECK( last_settled_day < cur_days, err::RECORD_SETTLED, "record is settled: " + to_string(id));
 
     // get amount
     auto symbol = asset_symbol( sttle.raw() );
@@ -103,20 +104,217 @@ ACTION sttlement::settlement( const name& owner, const uint64_t& id, const name&
 
     }
 
-    //update  settlement times and final settlement time
-    if( type == sttle_type::ADMIN ){
-       sttle.last_settled_at += eosio::days(1);;
+    //update  settlement times and final settlement time, one day per call for ADMIN and OWNER alike
+    sttle.set_last_settled_day( last_settled_day + 1 );
+    sttle.sttle_times ++;
+    //sttle.earning.amount += user_revenue;
+    _db.set( sttle );
+    _set_due( sttle );
+}
 
-    }
+ACTION sttlement::settleall( const name& owner, const uint32_t& max_rows ) {
+    CHECK( has_auth(_self) || has_auth(owner), err::NO_AUTH, "no permistion for settleall");
+    CHECK( max_rows > 0, err::PARAM_INCORRECT, "max_rows must be positive");
 
-    if( type == sttle_type::OWNER ){
-       sttle.last_settled_at = current_time_point();
+    uint32_t cur_days = current_time_point().sec_since_epoch() / seconds_per_day;
 
+    sttle_t::idx_t sttles(_self, _self.value);
+    auto sttle_index = sttles.get_index<"unionid"_n>();
+    auto itr = sttle_index.lower_bound( get_union_id( owner, 0, 0 ) );
+
+    map<uint32_t, tokenstats_t>             tokens;     //token_id => tokenstats
+    map<uint32_t, map<uint32_t, int64_t>>   balances;   //token_id => sub_token_id => balance
+    map<symbol, asset>                      burns;      //electricity charges by symbol
+    int64_t total_earning = 0;
+
+    // only settled records count toward max_rows
+    for (uint32_t i = 0; i < max_rows && itr != sttle_index.end() && itr->owner == owner; itr++) {
+        if ( itr->status != sttle_status::START ) continue;
+        uint32_t last_settled_days = itr->last_settled_day();
+        if ( last_settled_days >= cur_days ) continue;
+
+        auto token_itr = tokens.find( itr->token_id );
+        if ( token_itr == tokens.end() ) {
+            tokenstats_t tokenstats( itr->token_id );
+            CHECK( _apollo_db.get( tokenstats ), err::RECORD_NOT_FOUND, "the token not found:  " + to_string(itr->token_id) );
+            token_itr = tokens.emplace( itr->token_id, tokenstats ).first;
+
+            // one range walk per token_id instead of one account read per record
+            vector<token_asset> token_balances;
+            get_token_balances( APOLLO_TOKEN, owner, itr->token_id, token_balances );
+            for (const auto& balance : token_balances) {
+                balances[ itr->token_id ][ balance.symbol.sub_token_id ] = balance.amount;
+            }
+        }
+        // records whose balance was sold or merged away earn nothing, skip them
+        auto balance_itr = balances[ itr->token_id ].find( itr->sub_token_id );
+        if ( balance_itr == balances[ itr->token_id ].end() ) continue;
+
+        power_asset_variables variables = std::get<power_asset_variables>(token_itr->second.vars);
+        pow_asset_invariables invariables = std::get<pow_asset_invariables>(token_itr->second.invars);
+        if ( _calc_settle_days( *itr, invariables, 1 ) == 0 ) continue;
+
+        int64_t user_earning = _calc_earning( balance_itr->second, variables );
+        if ( user_earning <= 0 ) continue;
+        total_earning += user_earning;
+
+        auto charge = variables.daily_electricity_charge;
+        auto burn_itr = burns.find( charge.symbol );
+        if ( burn_itr == burns.end() ) burns.emplace( charge.symbol, charge );
+        else burn_itr->second += charge;
+
+        sttle_index.modify( itr, same_payer, [&]( auto& item ) {
+            item.set_last_settled_day( last_settled_days + 1 );
+            item.sttle_times ++;
+        });
+        _set_due( *itr );
+        i++;
     }
+    CHECK( total_earning > 0, err::RECORD_SETTLED, "no record to settle: " + owner.to_string());
 
-    sttle.sttle_times ++;
-    //sttle.earning.amount += user_revenue;
+    //deduction of electricity, one burn per charge symbol
+    for (const auto& [sym, quantity] : burns) {
+        BURN( APOLLO_EV, owner, quantity, string("settlement consume") );
+    }
+
+    //increase revenue
+    AM_TRANSFER( AM_TOKEN, owner, asset(total_earning, AM_SYMBOL), string("earning transfer") );
+}
+
+ACTION sttlement::settledays( const uint64_t& id, const uint16_t& max_days ) {
+    CHECK( max_days > 0, err::PARAM_INCORRECT, "max_days must be positive");
+
+    sttle_t sttle( id );
+    CHECK( _db.get( sttle ), err::RECORD_NOT_FOUND, "record not found: " + to_string(id));
+    CHECK( has_auth(_self) || has_auth(sttle.owner), err::NO_AUTH, "no permistion for settledays");
+    CHECK( sttle.status != sttle_status::PAUSE, err::PAUSED, "record is already paused");
+    CHECK( sttle.status != sttle_status::DEL, err::RECORD_DEL, "record is already delete");
+
+    uint32_t cur_days = current_time_point().sec_since_epoch() / seconds_per_day;
+    uint32_t last_settled_days = sttle.last_settled_day();
+    CHECK( last_settled_day < cur_days, err::RECORD_SETTLED, "record is settled: " + to_string(id));
+
+    auto symbol = asset_symbol( sttle.raw() );
+    auto tokenasset = token_asset( symbol );
+    account_t account( tokenasset );
+    CHECK( _apollo_db.get( sttle.owner.value, account ), err::RECORD_NOT_FOUND, "the account not found: " + to_string( tokenasset.symbol.raw() ) );
+
+    tokenstats_t tokenstats( sttle.token_id );
+    CHECK( _apollo_db.get( tokenstats ), err::RECORD_NOT_FOUND, "the token not found:  " + to_string(sttle.token_id) );
+    power_asset_variables variables = std::get<power_asset_variables>(tokenstats.vars);
+    pow_asset_invariables invariables = std::get<pow_asset_invariables>(tokenstats.invars);
+
+    // every day earns and consumes the same, so k days settle as k times one day
+    uint16_t days = _calc_settle_days( sttle, invariables, std::min<uint32_t>( max_days, cur_days - last_settled_days ) );
+    CHECK( days > 0, err::RECORD_SETTLED, "service life ended: " + to_string(id));
+
+    int64_t user_earning = _calc_earning( account.balance.amount, variables );
+    CHECK( user_earning > 0, err::NOT_POSITIVE, "settlement transfer must positive quantity " + to_string(id));
+
+    //deduction of electricity
+    auto charge = variables.daily_electricity_charge;
+    charge.amount = multiply_i64( charge.amount, days );
+    BURN( APOLLO_EV, sttle.owner, charge, string("settlement consume") );
+
+    //increase revenue
+    AM_TRANSFER( AM_TOKEN, sttle.owner, asset(multiply_i64( user_earning, days ), AM_SYMBOL), string("earning transfer") );
+
+    sttle.set_last_settled_day( last_settled_days + days );
+    sttle.sttle_times += days;
     _db.set( sttle );
+    _set_due( sttle );
+}
+
+ACTION sttlement::crank( const uint32_t& day, const uint128_t& cursor, const uint32_t& max_rows ) {
+    require_auth( _self );
+    CHECK( max_rows > 0, err::PARAM_INCORRECT, "max_rows must be positive");
+    CHECK( day <= current_time_point().sec_since_epoch() / seconds_per_day, err::PARAM_INCORRECT, "day not reached: " + to_string(day));
+
+    // due START records: last_settled_day < day, in (last_settled_day, pk_id) order
+    sttle_due_t::idx_t dues(_self, _self.value);
+    auto due_index = dues.get_index<"duedate"_n>();
+    auto upper = get_due_key( sttle_status::START, day, 0 );
+    auto itr = due_index.lower_bound( std::max( cursor, get_due_key( sttle_status::START, 0, 0 ) ) );
+
+    map<uint32_t, tokenstats_t>         tokens;     //token_id => tokenstats
+    map<name, int64_t>                  earnings;   //owner => earning
+    map<pair<name, symbol>, asset>      burns;      //owner, charge symbol => electricity charge
+    uint32_t settled_count = 0;
+
+    for (uint32_t i = 0; i < max_rows && itr != due_index.end() && itr->by_due() < upper; i++) {
+        // settling moves the due row past upper, so step off it first
+        auto pk_id = itr->pk_id;
+        itr++;
+
+        // a bad record is skipped, never aborts the crank for everyone else
+        sttle_t sttle( pk_id );
+        if ( !_db.get( sttle ) ) {
+            _db.del( sttle_due_t( pk_id ) );
+            continue;
+        }
+
+        auto token_itr = tokens.find( sttle.token_id );
+        if ( token_itr == tokens.end() ) {
+            tokenstats_t tokenstats( sttle.token_id );
+            if ( !_apollo_db.get( tokenstats ) ) continue;
+            token_itr = tokens.emplace( sttle.token_id, tokenstats ).first;
+        }
+        power_asset_variables variables = std::get<power_asset_variables>(token_itr->second.vars);
+        pow_asset_invariables invariables = std::get<pow_asset_invariables>(token_itr->second.invars);
+
+        // service life ended, the record will never be due again
+        uint32_t last_settled_days = sttle.last_settled_day();
+        uint16_t days = _calc_settle_days( sttle, invariables, day - last_settled_days );
+        if ( days == 0 ) {
+            _db.del( sttle_due_t( pk_id ) );
+            continue;
+        }
+
+        // balance sold to zero or merged away
+        account_t account( token_asset( asset_symbol( sttle.raw() ) ) );
+        if ( !_apollo_db.get( sttle.owner.value, account ) ) continue;
+
+        int64_t user_earning = _calc_earning( account.balance.amount, variables );
+        if ( user_earning <= 0 ) continue;
+        earnings[ sttle.owner ] += multiply_i64( user_earning, days );
+
+        auto charge = variables.daily_electricity_charge;
+        charge.amount = multiply_i64( charge.amount, days );
+        auto burn_itr = burns.find( {sttle.owner, charge.symbol} );
+        if ( burn_itr == burns.end() ) burns.emplace( make_pair(sttle.owner, charge.symbol), charge );
+        else burn_itr->second += charge;
+
+        sttle.set_last_settled_day( last_settled_days + days );
+        sttle.sttle_times += days;
+        _db.set( sttle );
+        _set_due( sttle );
+        settled_count++;
+    }
+
+    for (const auto& [key, quantity] : burns) {
+        BURN( APOLLO_EV, key.first, quantity, string("settlement consume") );
+    }
+    for (const auto& [owner, earning] : earnings) {
+        AM_TRANSFER( AM_TOKEN, owner, asset(earning, AM_SYMBOL), string("earning transfer") );
+    }
+
+    crank_singleton crank_tbl(_self, _self.value);
+    crank_t crank;
+    crank.day           = day;
+    crank.next_key      = ( itr != due_index.end() && itr->by_due() < upper ) ? itr->by_due() : 0;
+    crank.settled_count = settled_count;
+    crank_tbl.set( crank, _self );
+}
+
+ACTION sttlement::indexdue( const uint64_t& cursor, const uint32_t& max_rows ) {
+    require_auth( _self );
+    CHECK( max_rows > 0, err::PARAM_INCORRECT, "max_rows must be positive");
+
+    sttle_t::idx_t sttles(_self, _self.value);
+    auto itr = sttles.lower_bound( cursor );
+    for (uint32_t i = 0; i < max_rows && itr != sttles.end(); itr++, i++) {
+        _set_due( *itr );
+    }
 }
 
 ACTION sttlement::pause( const name& owner, const uint64_t& id ) {
@@ -129,6 +327,7 @@ ACTION sttlement::pause( const name& owner, const uint64_t& id ) {
     sttle.status = sttle_status::PAUSE;
 
     _db.set( sttle );
+    _set_due( sttle );
 }
 
 ACTION sttlement::destory( const name& owner, const uint64_t& id ) {
@@ -140,6 +339,7 @@ ACTION sttlement::destory( const name& owner, const uint64_t& id ) {
     sttle.status = sttle_status::DEL;
 
     _db.set( sttle );
+    _set_due( sttle );
 }
 
 ACTION sttlement::start( const name& owner, const uint64_t& id ) {
@@ -152,6 +352,30 @@ ACTION sttlement::start( const name& owner, const uint64_t& id ) {
     sttle.status = sttle_status::START;
 
     _db.set( sttle );
+    _set_due( sttle );
+}
+
+void sttlement::_set_due( const sttle_t& sttle ) {
+    sttle_due_t due( sttle.pk_id );
+    if ( sttle.status == sttle_status::DEL ) {
+        _db.del( due );
+        return;
+    }
+    due.status              = sttle.status;
+    due.last_settled_day    = sttle.last_settled_day();
+    _db.set( due );
+}
+
+// days of the next `days` that are still within the service life
+uint16_t sttlement::_calc_settle_days( const sttle_t& sttle, const pow_asset_invariables& invariables, const uint16_t& days ) {
+    if ( sttle.sttle_times >= invariables.service_life_days ) return 0;
+    return std::min<uint16_t>( days, invariables.service_life_days - sttle.sttle_times );
+}
+
+// daily earning after the service fee
+int64_t sttlement::_calc_earning( const int64_t& balance, const power_asset_variables& variables ) {
+    int64_t total_earning = multiply_revenue( variables.actual_hash_rate.value, multiply_decimal64( balance, variables.daily_earning_est.amount, get_precision(variables.daily_earning_est) ) );
+    return multiply_decimal64( 10000 - variables.daily_svcfee_rate, total_earning, 10000 );
 }
 
 } /// namespace apollo
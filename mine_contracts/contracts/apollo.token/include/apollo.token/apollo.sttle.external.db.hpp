@@ -0,0 +1,63 @@
+ #pragma once
+
+#include <eosio/asset.hpp>
+#include <eosio/system.hpp>
+#include <eosio/time.hpp>
+
+#include "apollo.token/apollo.token.db.hpp"
+
+using namespace eosio;
+
+static constexpr eosio::name APOLLO_STTLE{"apollo.sttle"_n};
+
+namespace apollo {
+
+using namespace std;
+using namespace eosio;
+
+namespace sttle_status {
+    static constexpr eosio::name PAUSE          = "pause"_n;
+    static constexpr eosio::name START          = "start"_n;
+    static constexpr eosio::name DEL            = "del"_n;
+
+};
+
+// settlement records of apollo.sttle, scope: APOLLO_STTLE
+struct sttle_t {
+    uint64_t       pk_id;
+    name           owner;
+    name           beneficiary;
+    name           status;
+    time_point     last_settled_at;
+    uint32_t       token_id;
+    uint32_t       sub_token_id;
+    token_asset    earning;
+    uint16_t       sttle_times = 0;
+
+    uint64_t    primary_key()const { return pk_id; }
+    uint128_t   by_union_id()const {
+        return ( (uint128_t)owner.value ) << 64 | ((uint64_t)token_id << 32 | sub_token_id);
+
+    }
+
+    typedef eosio::multi_index
+            <"sttles"_n, sttle_t,
+             indexed_by<"unionid"_n, const_mem_fun<sttle_t, uint128_t, &sttle_t::by_union_id> >
+     > idx_t;
+
+     EOSLIB_SERIALIZE( sttle_t, (pk_id)(owner)(beneficiary)(status)(last_settled_at)(token_id)(sub_token_id)(earning)(sttle_times) )
+};
+
+//true if owner's balance of token_id:sub_token_id is still tracked by a START or PAUSE settlement record
+inline bool has_open_sttle( const name& owner, const uint32_t& token_id, const uint32_t& sub_token_id ) {
+    sttle_t::idx_t sttles(APOLLO_STTLE, APOLLO_STTLE.value);
+    auto union_idx = sttles.get_index<"unionid"_n>();
+    uint128_t key = ( (uint128_t)owner.value ) << 64 | ((uint64_t)token_id << 32 | sub_token_id);
+
+    for (auto itr = union_idx.lower_bound( key ); itr != union_idx.end() && itr->by_union_id() == key; itr++) {
+        if (itr->status == sttle_status::START || itr->status == sttle_status::PAUSE) return true;
+    }
+    return false;
+}
+
+} // apollo
@@ -1,6 +1,7 @@
  #pragma once
 
 #include <eosio/asset.hpp>
+#include <eosio/binary_extension.hpp>
 #include <eosio/privileged.hpp>
 #include <eosio/singleton.hpp>
 #include <eosio/system.hpp>
@@ -70,6 +71,36 @@ struct [[eosio::table("global"), eosio::contract("apollo.token")]] global_t {
 };
 typedef eosio::singleton< "global"_n, global_t > global_singleton;
 
+//pause flags of all tokens, bit token_id % 64 of words[token_id / 64];
+//bits are authoritative below synced_upto (backfilled by syncpause) and from created_from on
+//(created with the bitmap in place), other tokens read tokensupply_t.paused
+struct [[eosio::table("pausemap"), eosio::contract("apollo.token")]] pause_bitmap_t {
+    vector<uint64_t> words;
+    uint64_t synced_upto    = 1;    //token ids start at 1
+    uint64_t created_from   = 0;    //0: no token created since the bitmap was added
+
+    bool is_mirrored(const uint64_t& token_id)const {
+        return token_id < synced_upto || (created_from > 0 && token_id >= created_from);
+    }
+
+    bool is_paused(const uint64_t& token_id)const {
+        auto idx = token_id / 64;
+        return idx < words.size() && (words[idx] >> (token_id % 64) & 1);
+    }
+
+    void set_paused(const uint64_t& token_id, const bool& paused) {
+        auto idx = token_id / 64;
+        if (idx >= words.size()) words.resize(idx + 1, 0);
+        if (paused)
+            words[idx] |= (uint64_t) 1 << (token_id % 64);
+        else
+            words[idx] &= ~((uint64_t) 1 << (token_id % 64));
+    }
+
+    EOSLIB_SERIALIZE( pause_bitmap_t, (words)(synced_upto)(created_from) )
+};
+typedef eosio::singleton< "pausemap"_n, pause_bitmap_t > pause_bitmap_singleton;
+
 enum class nft_type: uint8_t {
     NONE        = 0,
     POW         = 1,
@@ -168,6 +199,7 @@ struct power_asset_variables {
 typedef std::variant<pow_asset_invariables /*pos_asset_invariables */> token_invars;
 typedef std::variant<power_asset_variables /*pos_asset_variables */> token_vars;
 
+//Note: token metadata, read by UIs and create; supply and paused are kept in tokensupply_t
 TBL tokenstats_t {
     uint64_t        token_id;       //PK
     uint8_t         token_type;     //POW, POS, ...etc
@@ -175,22 +207,26 @@ TBL tokenstats_t {
     token_invars    invars;         //used to derive first part of token asset ID
     token_vars      vars;
     int64_t         max_supply;     //when amount is 1, it means NFT-721 type
-    int64_t         supply;
+    int64_t         supply;         //legacy, superseded by tokensupply_t.supply
     name            creator;
     time_point_sec  created_at;
-    bool            paused;
+    bool            paused;         //legacy, superseded by tokensupply_t.paused
+    binary_extension<checksum256> invars_hash;  //computed once at create, read by tokeninvars index
 
     tokenstats_t() {};
     tokenstats_t(const uint64_t& id): token_id(id) {};
 
     uint64_t primary_key()const { return token_id; }
     uint64_t by_token_type()const { return (uint64_t) token_type; }
-    checksum256 by_token_invars()const { 
+    checksum256 calc_token_invars()const { 
         if (token_type == (uint8_t) token_type::POW)
             return std::get<pow_asset_invariables>(invars).hash(to_string(token_type)); 
         else 
             return checksum256();
     }
+    checksum256 by_token_invars()const { 
+        return invars_hash.has_value() ? invars_hash.value() : calc_token_invars();
+    }
     typedef eosio::multi_index
     < "tokenstats"_n,  tokenstats_t,
         indexed_by<"tokentypes"_n, const_mem_fun<tokenstats_t, uint64_t, &tokenstats_t::by_token_type> >,
@@ -198,10 +234,28 @@ TBL tokenstats_t {
     > idx_t;
 
     EOSLIB_SERIALIZE(tokenstats_t,  (token_id)(token_type)(token_uri)(invars)(vars)(max_supply)(supply)
-                                    (creator)(created_at)(paused) )
+                                    (creator)(created_at)(paused)(invars_hash) )
 };
 
 
+//Note: fixed size supply ledger of tokenstats_t, read and written by issue, retire and transfer
+TBL tokensupply_t {
+    uint64_t        token_id;       //PK, tokenstats_t.token_id
+    int64_t         max_supply;
+    int64_t         supply;
+    name            creator;
+    bool            paused = false;
+
+    tokensupply_t() {};
+    tokensupply_t(const uint64_t& id): token_id(id) {};
+
+    uint64_t primary_key()const { return token_id; }
+
+    typedef eosio::multi_index< "tokensupply"_n, tokensupply_t > idx_t;
+
+    EOSLIB_SERIALIZE(tokensupply_t, (token_id)(max_supply)(supply)(creator)(paused) )
+};
+
 // struct fee_discount_config { //apply to token_id level for all sub_token_ids
 //     time_point_sec begin;
 //     time_point_sec end;
@@ -225,4 +279,17 @@ TBL account_t {
 
 };
 
+//range walk of owner's balances of one token_id over all its sub_token_ids, returns the sum
+inline int64_t get_token_balances( const name& contract, const name& owner, const uint32_t& token_id, vector<token_asset>& balances ) {
+    account_t::idx_t accounts(contract, owner.value);
+    uint64_t upper = ((uint64_t) token_id + 1) << 32;
+
+    int64_t total = 0;
+    for (auto itr = accounts.lower_bound( (uint64_t) token_id << 32 ); itr != accounts.end() && itr->primary_key() < upper; itr++) {
+        total += itr->balance.amount;
+        balances.push_back( itr->balance );
+    }
+    return total;
+}
+
 } // apollo
@@ -5,10 +5,12 @@
 #include <string>
 #include <wasm_db.hpp>
 #include "apollo.token/apollo.token.db.hpp"
+#include "apollo.token/apollo.sttle.external.db.hpp"
 
 namespace apollo {
 
 using std::string;
+using std::vector;
 using namespace eosio;
 using namespace wasm::db;
 
@@ -21,6 +23,7 @@ private:
    dbc                 _db;
    global_singleton    _global;
    global_t            _gstate;
+   std::optional<pause_bitmap_t> _pauses;    //loaded on first pause check
 
 public:
    using contract::contract;
@@ -47,6 +50,14 @@ public:
    ACTION create( const name& issuer, const uint8_t& token_type, const string& uri, 
                     const token_invars& invars, const token_vars& vars, const int64_t& maximum_supply );
 
+   /*
+    * Backfill invars_hash of tokens created before it was stored
+    *
+    * @param cursor - token_id to start from
+    * @param max_rows - max tokens to visit in this action
+    */
+   ACTION fillinvhash( const uint64_t& cursor, const uint32_t& max_rows );
+
    /**
     *  This action issues to `to` account a `quantity` of tokens.
     *
@@ -56,6 +67,18 @@ public:
     */
    ACTION issue( const name& to, const token_asset& quantity, const string& memo );
 
+   /**
+    *  This action issues tokens of `token_id` directly to several accounts, with one supply update.
+    *
+    * @param token_id - the token to issue, signed by its creator,
+    * @param recipients - the accounts and amounts to credit,
+    * @param memo - the memo string that accompanies the token issue transaction, at most 256 bytes,
+    *               delivered to every recipient with the notification,
+    * @param notify - optional, false to skip recipient notifications.
+    */
+   ACTION issuebatch( const uint32_t& token_id, const vector<pair<name, int64_t>>& recipients, const string& memo,
+                      const binary_extension<bool>& notify );
+
    ACTION retire( const token_asset& quantity, const string& memo );
 
    /*
@@ -74,13 +97,62 @@ public:
    ACTION transfer(const name& from, const name& to, token_asset& quantity, const string& memo );
    using transfer_action = action_wrapper< "transfer"_n, &token::transfer >;
 
+   /*
+    * Transfers several assets in one action.
+    *
+    * Quantities of the same symbol are merged, each token is read once
+    * and from/to are notified once.
+    *
+    * @param from is account who sends the assets.
+    * @param to is account of receiver.
+    * @param quantities is array of token assets to transfer.
+    * @param memo is transfers comment.
+    */
+   ACTION transferx(const name& from, const name& to, const vector<token_asset>& quantities, const string& memo );
+   using transferx_action = action_wrapper< "transferx"_n, &token::transferx >;
+
+   /*
+    * Fold several day-bucket balances of one token into the oldest one.
+    *
+    * All rows must share one beneficiary, and none may be tracked by a START
+    * or PAUSE settlement record of apollo.sttle.
+    *
+    * @param owner is the balance owner.
+    * @param token_id is the token of the balances.
+    * @param sub_ids are the sub token ids to fold, including target_sub_id.
+    * @param target_sub_id is the oldest of sub_ids, its row receives the sum, the others are deleted.
+    */
+   ACTION merge(const name& owner, const uint32_t& token_id, const vector<uint32_t>& sub_ids, const uint32_t& target_sub_id );
+
+   /**
+    * Read-only balance query: reports the sum and the per sub id balances of owner's token_id
+    * through an inline balancelog action, nothing is written.
+    *
+    * @param owner is the balance owner.
+    * @param token_id is the token of the balances.
+    */
+   ACTION balancesof(const name& owner, const uint32_t& token_id );
+   ACTION balancelog(const name& owner, const uint32_t& token_id, const int64_t& total, const vector<token_asset>& balances );
+   using balancelog_action = action_wrapper< "balancelog"_n, &token::balancelog >;
+
    ACTION pausetoken(const uint64_t& token_id, const bool paused);
+   /*
+    * Copy the paused flag of tokens created before the pause bitmap existed into it, in token id order.
+    * Optional: tokens not backfilled yet are checked against their supply row.
+    *
+    * @param max_rows - tokens to sync in this call, the walk resumes where the last call stopped
+    */
+   ACTION syncpause(const uint32_t& max_rows);
    ACTION pauseaccount(const name& owner, const asset_symbol& symbol, const bool paused);
 
 
 private:
    void add_balance( const name& owner, const token_asset& value );
    void sub_balance( const name& owner, const token_asset& value );
+   bool _is_token_paused( const uint64_t& token_id );
+   pause_bitmap_t& _get_pauses();
+   void _save_pauses();
+   bool _get_supply( tokensupply_t& supply );
    inline uint64_t gen_sub_token_id(const time_point_sec& now);
 };
 } //namespace apollo
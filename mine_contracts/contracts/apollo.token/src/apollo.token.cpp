@@ -25,7 +25,7 @@ ACTION token::create( const name& issuer, const uint8_t& token_type, const strin
    CHECKC(token_uri.length() < 1024, err::OVERSIZED, "token_uri length > 1024: " + to_string(token_uri.length()) )
 
    tokenstats_t::idx_t tokenstats(_self, _self.value);
-   tokenstats.emplace( _self, [&]( auto& item ) {
+   auto itr = tokenstats.emplace( _self, [&]( auto& item ) {
       item.token_id     = tokenstats.available_primary_key(); if (item.token_id == 0) item.token_id = 1; 
       item.token_type   = token_type;
       item.token_uri    = token_uri;
@@ -34,15 +34,45 @@ ACTION token::create( const name& issuer, const uint8_t& token_type, const strin
       item.max_supply   = maximum_supply;
       item.creator      = issuer;
       item.created_at   = time_point_sec( current_time_point() );
+      item.invars_hash.emplace( item.calc_token_invars() );
    });
+
+   auto supply = tokensupply_t( itr->token_id );
+   supply.max_supply    = maximum_supply;
+   supply.supply        = 0;
+   supply.creator       = issuer;
+   supply.paused        = false;
+   _db.set( supply );
+
+   // new tokens start unpaused, their bits are already clear
+   auto& pauses = _get_pauses();
+   if (pauses.created_from == 0) {
+      pauses.created_from = supply.token_id;
+      _save_pauses();
+   }
+}
+
+ACTION token::fillinvhash( const uint64_t& cursor, const uint32_t& max_rows ) {
+   require_auth( _gstate.admin );
+   CHECKC(max_rows > 0, err::NOT_POSITIVE, "max_rows must be positive" )
+
+   tokenstats_t::idx_t tokenstats(_self, _self.value);
+   auto itr = tokenstats.lower_bound(cursor);
+   for (uint32_t i = 0; i < max_rows && itr != tokenstats.end(); itr++, i++) {
+      if (itr->invars_hash.has_value()) continue;
+
+      tokenstats.modify( itr, same_payer, [&]( auto& item ) {
+         item.invars_hash.emplace( item.calc_token_invars() );
+      });
+   }
 }
 
 ACTION token::issue( const name& to, const token_asset& quantity, const string& memo )
 {
    CHECKC(memo.size() <= 256, err::OVERSIZED, "memo has more than 256 bytes" )
 
-   auto stats = tokenstats_t(quantity.symbol.token_id);
-   CHECKC(_db.get(stats), err::RECORD_NOT_FOUND, "token not found: " + to_string(quantity.symbol.token_id) )
+   auto stats = tokensupply_t(quantity.symbol.token_id);
+   CHECKC(_get_supply(stats), err::RECORD_NOT_FOUND, "token not found: " + to_string(quantity.symbol.token_id) )
    CHECKC(to == stats.creator, err::NO_AUTH, "tokens can only be issued to token creator" )
    require_auth( stats.creator );
   
@@ -56,12 +86,44 @@ ACTION token::issue( const name& to, const token_asset& quantity, const string&
    add_balance( stats.creator, quantity );
 }
 
+ACTION token::issuebatch( const uint32_t& token_id, const vector<pair<name, int64_t>>& recipients, const string& memo,
+                          const binary_extension<bool>& notify )
+{
+   CHECKC(memo.size() <= 256, err::OVERSIZED, "memo has more than 256 bytes" )
+   CHECKC(recipients.size() > 0, err::PARAM_INCORRECT, "recipients is empty" )
+
+   auto stats = tokensupply_t(token_id);
+   CHECKC(_get_supply(stats), err::RECORD_NOT_FOUND, "token not found: " + to_string(token_id) )
+   require_auth( stats.creator );
+
+   auto now = time_point_sec( current_time_point() );
+   bool is_notify = notify.value_or(true);
+   int64_t total = 0;
+   for (const auto& [to, amount] : recipients) {
+      CHECKC(is_account( to ), err::RECORD_NOT_FOUND, "to account does not exist: " + to.to_string() )
+      CHECKC(amount > 0, err::NOT_POSITIVE, "must issue positive quantity" )
+      CHECKC(amount <= stats.max_supply - stats.supply - total, err::OVERSIZED, "quantity exceeds available supply");
+      total += amount;
+
+      // recipients receive as if bought from decommerce, except decommerce itself
+      auto quantity = token_asset( asset_symbol((uint64_t) token_id << 32 |
+                                   (to == _gstate.decommerce_contract ? 0 : gen_sub_token_id(now))) );
+      quantity.amount = amount;
+      add_balance( to, quantity );
+
+      if (is_notify) require_recipient( to );
+   }
+
+   stats.supply += total;
+   _db.set( stats );
+}
+
 ACTION token::retire( const token_asset& quantity, const string& memo )
 {
    CHECKC(memo.size() <= 256, err::OVERSIZED, "memo has more than 256 bytes" )
 
-   auto token = tokenstats_t(quantity.symbol.token_id);
-   CHECKC(_db.get(token), err::RECORD_NOT_FOUND, "token asset not found: " + to_string(quantity.symbol.token_id) )
+   auto token = tokensupply_t(quantity.symbol.token_id);
+   CHECKC(_get_supply(token), err::RECORD_NOT_FOUND, "token asset not found: " + to_string(quantity.symbol.token_id) )
 
    require_auth( token.creator );
    CHECKC(quantity.amount > 0, err::NOT_POSITIVE, "must retire positive quantity" )
@@ -80,17 +142,14 @@ ACTION token::transfer( const name& from, const name& to, token_asset& quantity,
 
    require_auth( from );
    CHECKC(is_account( to ), err::RECORD_NOT_FOUND, "to account does not exist");
-   auto tokenid = quantity.symbol.token_id;
-   auto token = tokenstats_t(tokenid);
-   CHECKC(_db.get(token), err::RECORD_NOT_FOUND, "token asset not found: " + to_string(tokenid) )
 
    require_recipient( from );
    require_recipient( to );
 
    CHECKC(quantity.amount > 0, err::NOT_POSITIVE, "must transfer positive quantity" );
-   CHECKC(quantity.symbol.token_id == token.token_id, err::SYMBOL_MISMATCH, "token_id mismatch" )
    CHECKC(memo.size() <= 256, err::OVERSIZED, "memo has more than 256 bytes" )
 
+   // the token exists whenever the sender holds a balance of it
    sub_balance( from, quantity );
    if (to == _gstate.decommerce_contract) {           //transfer: to sell or resell
       quantity.symbol.sub_token_id = 0;
@@ -102,6 +161,107 @@ ACTION token::transfer( const name& from, const name& to, token_asset& quantity,
 
 }
 
+ACTION token::transferx( const name& from, const name& to, const vector<token_asset>& quantities, const string& memo ) {
+   CHECKC(from != to, err::NO_AUTH, "cannot transfer to self" );
+   
+   auto now = current_time_point();
+   CHECKC(now.sec_since_epoch() > start_time_since_epoch, err::NOT_STARTED, "not started yet" )
+
+   require_auth( from );
+   CHECKC(is_account( to ), err::RECORD_NOT_FOUND, "to account does not exist");
+   CHECKC(quantities.size() > 0, err::PARAM_INCORRECT, "quantities is empty" )
+   CHECKC(memo.size() <= 256, err::OVERSIZED, "memo has more than 256 bytes" )
+
+   require_recipient( from );
+   require_recipient( to );
+
+   // merge by symbol raw, so each account row is read and written once; pause flags come from one bitmap read
+   map<uint64_t, int64_t> subs;
+   for (const auto& quantity : quantities) {
+      CHECKC(quantity.amount > 0, err::NOT_POSITIVE, "must transfer positive quantity" );
+      subs[ quantity.symbol.raw() ] += quantity.amount;
+   }
+
+   map<uint64_t, int64_t> adds;
+   for (const auto& [raw, amount] : subs) {
+      auto quantity = token_asset( asset_symbol(raw) );
+      quantity.amount = amount;
+      sub_balance( from, quantity );
+
+      if (to == _gstate.decommerce_contract) {           //transfer: to sell or resell
+         quantity.symbol.sub_token_id = 0;
+
+      } else if (from == _gstate.decommerce_contract) {  //transfer: to buy
+         quantity.symbol.sub_token_id = gen_sub_token_id(now);
+      }
+      adds[ quantity.symbol.raw() ] += quantity.amount;
+   }
+
+   for (const auto& [raw, amount] : adds) {
+      auto quantity = token_asset( asset_symbol(raw) );
+      quantity.amount = amount;
+      add_balance( to, quantity );
+   }
+}
+
+ACTION token::merge( const name& owner, const uint32_t& token_id, const vector<uint32_t>& sub_ids, const uint32_t& target_sub_id ) {
+   require_auth( owner );
+   CHECKC(sub_ids.size() > 1, err::PARAM_INCORRECT, "sub_ids must have more than one sub id" )
+   CHECKC(target_sub_id == *std::min_element(sub_ids.begin(), sub_ids.end()), err::PARAM_INCORRECT,
+          "target sub id must be the oldest of sub_ids: " + to_string(target_sub_id) )
+
+   auto token = tokensupply_t(token_id);
+   CHECKC(_get_supply(token), err::RECORD_NOT_FOUND, "token asset not found: " + to_string(token_id) )
+   CHECKC(!token.paused, err::PAUSED, "token being paused: " + to_string(token_id) )
+
+   auto to_acnt = account_t( token_asset( asset_symbol((uint64_t) token_id << 32 | target_sub_id) ) );
+   CHECKC( _db.get(owner.value, to_acnt), err::RECORD_NOT_FOUND, "account balance not found: " + to_string(target_sub_id) )
+   CHECKC( !to_acnt.paused, err::PAUSED, "account balance being paused: " + to_string(target_sub_id) )
+   CHECKC( !has_open_sttle(owner, token_id, target_sub_id), err::PARAM_INCORRECT, "sub id being settled: " + to_string(target_sub_id) )
+
+   set<uint32_t> merged_ids = { target_sub_id };
+   for (const auto& sub_id : sub_ids) {
+      if (sub_id == target_sub_id) continue;
+      CHECKC(merged_ids.insert(sub_id).second, err::PARAM_INCORRECT, "duplicate sub id: " + to_string(sub_id) )
+
+      auto from_acnt = account_t( token_asset( asset_symbol((uint64_t) token_id << 32 | sub_id) ) );
+      CHECKC( _db.get(owner.value, from_acnt), err::RECORD_NOT_FOUND, "account balance not found: " + to_string(sub_id) )
+      CHECKC( !from_acnt.paused, err::PAUSED, "account balance being paused: " + to_string(sub_id) )
+      CHECKC( from_acnt.beneficiary == to_acnt.beneficiary, err::PARAM_INCORRECT, "beneficiary mismatch: " + to_string(sub_id) )
+      CHECKC( !has_open_sttle(owner, token_id, sub_id), err::PARAM_INCORRECT, "sub id being settled: " + to_string(sub_id) )
+
+      to_acnt.balance.amount += from_acnt.balance.amount;
+      _db.del( owner.value, from_acnt );
+   }
+   _db.set( owner.value, to_acnt );
+}
+
+ACTION token::balancesof( const name& owner, const uint32_t& token_id ) {
+   vector<token_asset> balances;
+   auto total = get_token_balances( _self, owner, token_id, balances );
+
+   balancelog_action( _self, { {_self, "active"_n} } ).send( owner, token_id, total, balances );
+}
+
+ACTION token::balancelog( const name& owner, const uint32_t& token_id, const int64_t& total, const vector<token_asset>& balances ) {
+   require_auth( _self );
+}
+
+bool token::_get_supply( tokensupply_t& supply ) {
+   if (_db.get(supply)) return true;
+
+   // legacy token: copy the hot fields out of tokenstats once
+   auto stats = tokenstats_t(supply.token_id);
+   if (!_db.get(stats)) return false;
+
+   supply.max_supply    = stats.max_supply;
+   supply.supply        = stats.supply;
+   supply.creator       = stats.creator;
+   supply.paused        = stats.paused;
+   _db.set( supply );
+   return true;
+}
+
 void token::add_balance( const name& owner, const token_asset& value ) {
    auto to_acnt = account_t(value);
    if (_db.get(owner.value, to_acnt)) {
@@ -120,9 +280,7 @@ void token::sub_balance( const name& owner, const token_asset& value ) {
    CHECKC( !from_acnt.paused, err::PAUSED, "account balance being paused" )
    CHECKC( from_acnt.balance.amount >= value.amount, err::OVERSIZED, "overdrawn balance" );
 
-   auto token = tokenstats_t( from_acnt.balance.symbol.token_id );
-   CHECKC( _db.get(token), err::RECORD_NOT_FOUND, "token not found: " + to_string(token.token_id) )
-   CHECKC( !token.paused, err::PAUSED, "token being paused: " + to_string(token.token_id) )
+   CHECKC( !_is_token_paused(value.symbol.token_id), err::PAUSED, "token being paused: " + to_string(value.symbol.token_id) )
 
    from_acnt.balance -= value;
    _db.set( owner.value, from_acnt );
@@ -131,13 +289,59 @@ void token::sub_balance( const name& owner, const token_asset& value ) {
 void token::pausetoken(const uint64_t& token_id, const bool paused) {
    require_auth( _gstate.admin );
 
-   auto tokenstats = tokenstats_t(token_id);
-   CHECKC( _db.get(tokenstats), err::RECORD_NOT_FOUND, "token not found: " + to_string(token_id) )
-   CHECKC( tokenstats.paused != paused, err::PARAM_INCORRECT, "already paused: " + to_string(paused) )
+   auto supply = tokensupply_t(token_id);
+   CHECKC( _get_supply(supply), err::RECORD_NOT_FOUND, "token not found: " + to_string(token_id) )
+   CHECKC( supply.paused != paused, err::PARAM_INCORRECT, "already paused: " + to_string(paused) )
+
+   supply.paused = paused;
+   _db.set( supply );
+   _get_pauses().set_paused( token_id, paused );
+   _save_pauses();
+
+}
+
+void token::syncpause(const uint32_t& max_rows) {
+   require_auth( _gstate.admin );
+   CHECKC( max_rows > 0, err::NOT_POSITIVE, "max_rows must be positive" )
+
+   auto& pauses = _get_pauses();
+   tokenstats_t::idx_t tokenstats(_self, _self.value);
+   auto itr = tokenstats.lower_bound( pauses.synced_upto );
+   for (uint32_t i = 0; i < max_rows && itr != tokenstats.end(); itr++, i++) {
+      if (pauses.created_from > 0 && itr->token_id >= pauses.created_from) break;
+
+      auto supply = tokensupply_t(itr->token_id);
+      _get_supply( supply );
+      pauses.set_paused( itr->token_id, supply.paused );
+      pauses.synced_upto = itr->token_id + 1;
+   }
+   _save_pauses();
+}
+
+bool token::_is_token_paused( const uint64_t& token_id ) {
+   auto& pauses = _get_pauses();
+   if (pauses.is_mirrored( token_id )) return pauses.is_paused( token_id );
+
+   // not backfilled yet: read the supply row, or the legacy stats row, without writing
+   auto supply = tokensupply_t(token_id);
+   if (_db.get(supply)) return supply.paused;
 
-   tokenstats.paused = paused;
-   _db.set( tokenstats );
+   auto stats = tokenstats_t(token_id);
+   CHECKC( _db.get(stats), err::RECORD_NOT_FOUND, "token not found: " + to_string(token_id) )
+   return stats.paused;
+}
+
+pause_bitmap_t& token::_get_pauses() {
+   if (!_pauses) {
+      pause_bitmap_singleton pause_map(_self, _self.value);
+      _pauses = pause_map.get_or_default();
+   }
+   return *_pauses;
+}
 
+void token::_save_pauses() {
+   pause_bitmap_singleton pause_map(_self, _self.value);
+   pause_map.set( _get_pauses(), _self );
 }
 
 void token::pauseaccount(const name& owner, const asset_symbol& symbol, const bool paused) {
@@ -0,0 +1,400 @@
+#include "apollo_tester.hpp"
+
+class amax_savetwo_tester : public apollo_tester {
+public:
+   const name SAVETWO      = N(amax.savetwo);
+   const name SYS_BANK     = N(amax.token);
+   const name APLINK_BANK  = N(aplink.token);
+   const name APLINK_FARM  = N(aplink.farm);
+   const name ADMIN        = N(armoniaadmin);
+   const uint64_t LEASE_ID = 1;
+
+   amax_savetwo_tester() {
+      produce_blocks( 2 );
+
+      create_accounts( { SYS_BANK, APLINK_BANK, APLINK_FARM, SAVETWO, ADMIN, N(parent1), N(parent2) } );
+      create_account( N(alice), N(parent1) );
+      create_account( N(bob),   N(parent1) );
+      create_account( N(carol), N(parent2) );
+      produce_blocks( 2 );
+
+      deploy_contract( SYS_BANK,    contracts::deps::token_wasm(), contracts::deps::token_abi() );
+      deploy_contract( APLINK_BANK, contracts::deps::token_wasm(), contracts::deps::token_abi() );
+      deploy_contract( APLINK_FARM, contracts::deps::farm_wasm(),  contracts::deps::farm_abi() );
+      deploy_contract( SAVETWO,     contracts::savetwo_wasm(),     contracts::savetwo_abi() );
+      produce_blocks();
+
+      create_currency( SYS_BANK, SYS_BANK, asset::from_string("10000000000.00000000 AMAX") );
+      create_currency( APLINK_BANK, APLINK_BANK, asset::from_string("10000000000.0000 APL") );
+      for (auto& account : { ADMIN, N(alice), N(bob), N(carol) })
+         issue( SYS_BANK, SYS_BANK, account, asset::from_string("100000.00000000 AMAX") );
+      produce_blocks();
+   }
+
+   //lease LEASE_ID of aplink.farm, rented to amax.savetwo and stocked with apples
+   void open_farm_lease( const asset& apples ) {
+      BOOST_REQUIRE_EQUAL( success(), push_action( APLINK_FARM, APLINK_FARM, N(lease), mvo()
+         ("tenant", SAVETWO)
+         ("land_title", "amax save #2")
+         ("land_uri", "")
+         ("banner_uri", "")
+      ));
+      issue( APLINK_BANK, APLINK_BANK, APLINK_BANK, apples );
+      BOOST_REQUIRE_EQUAL( success(), transfer( APLINK_BANK, APLINK_BANK, APLINK_FARM, apples, to_string(LEASE_ID) ) );
+      BOOST_REQUIRE_EQUAL( success(), push_action( SAVETWO, SAVETWO, N(init), mvo()("farm_id", LEASE_ID) ) );
+   }
+
+   action_result createplan( const uint32_t& plan_days, const asset& plan_profit, const int64_t& total_quotas,
+                             const asset& apl_per_quota ) {
+      return push_action( SAVETWO, ADMIN, N(createplan), mvo()
+         ("plan_name", "plan")
+         ("type", "term")
+         ("stake_symbol", mvo()("sym", "8,AMAX")("contract", SYS_BANK))
+         ("interest_symbol", mvo()("sym", "8,AMAX")("contract", SYS_BANK))
+         ("plan_days", plan_days)
+         ("plan_profits", plan_profit)
+         ("total_quotas", total_quotas)
+         ("stake_per_quota", asset::from_string("1.00000000 AMAX"))
+         ("apl_per_quota", apl_per_quota)
+         ("begin_at", now())
+         ("end_at", now() + 365 * DAY_SECONDS)
+      );
+   }
+
+   action_result pledge( const name& from, const uint64_t& plan_id, const uint32_t& quotas ) {
+      auto quantity = asset( quotas * 100000000ll, symbol(8, "AMAX") );
+      return transfer( SYS_BANK, from, SAVETWO, quantity, "pledge:" + to_string(plan_id) + ":" + to_string(quotas) );
+   }
+
+   action_result refuel( const uint64_t& plan_id, const asset& quantity ) {
+      return transfer( SYS_BANK, ADMIN, SAVETWO, quantity, "refuelint:" + to_string(plan_id) );
+   }
+
+   action_result flushapl( const uint32_t& max_rows ) {
+      return push_action( SAVETWO, ADMIN, N(flushapl), mvo()("max_rows", max_rows) );
+   }
+
+   action_result collectint( const name& owner, const uint64_t& save_id ) {
+      return push_action( SAVETWO, owner, N(collectint), mvo()("issuer", owner)("owner", owner)("save_id", save_id) );
+   }
+
+   action_result migrate( const name& owner, const uint64_t& cursor, const uint32_t& max_rows ) {
+      return push_action( SAVETWO, ADMIN, N(migrate), mvo()("owner", owner)("cursor", cursor)("max_rows", max_rows) );
+   }
+
+   action_result migrateplan( const uint64_t& plan_id ) {
+      return push_action( SAVETWO, ADMIN, N(migrateplan), mvo()("plan_id", plan_id) );
+   }
+
+   action_result crank( const uint64_t& plan_id, const uint64_t& cursor, const uint32_t& max_rows ) {
+      return push_action( SAVETWO, ADMIN, N(crank), mvo()("plan_id", plan_id)("cursor", cursor)("max_rows", max_rows) );
+   }
+
+   asset get_amax_balance( const name& owner ) {
+      return get_balance( SYS_BANK, owner, symbol(8, "AMAX") );
+   }
+
+   fc::variant get_plan_conf( const uint64_t& plan_id ) {
+      return get_row( SAVETWO, SAVETWO.to_uint64_t(), N(planconf), plan_id );
+   }
+
+   fc::variant get_plan_state( const uint64_t& plan_id ) {
+      return get_row( SAVETWO, SAVETWO.to_uint64_t(), N(planstate), plan_id );
+   }
+
+   fc::variant get_save_acct( const name& owner, const uint64_t& save_id ) {
+      return get_row( SAVETWO, owner.to_uint64_t(), N(saveaccts), save_id );
+   }
+
+   fc::variant get_save_index( const uint64_t& save_id ) {
+      return get_row( SAVETWO, SAVETWO.to_uint64_t(), N(saveindex), save_id );
+   }
+
+   fc::variant get_apl_pending( const name& pledger ) {
+      return get_row( SAVETWO, SAVETWO.to_uint64_t(), N(aplpending), pledger.to_uint64_t() );
+   }
+
+   fc::variant get_lease( const uint64_t& lease_id ) {
+      return get_row( APLINK_FARM, APLINK_FARM.to_uint64_t(), N(leases), lease_id );
+   }
+};
+
+BOOST_AUTO_TEST_SUITE(amax_savetwo_tests)
+
+BOOST_FIXTURE_TEST_CASE( apl_pending_aggregated_per_pledger, amax_savetwo_tester ) try {
+   open_farm_lease( asset::from_string("1000.0000 APL") );
+   BOOST_REQUIRE_EQUAL( success(), createplan( 30, asset::from_string("0.10000000 AMAX"), 1000, asset::from_string("1.0000 APL") ) );
+   produce_blocks();
+
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(alice), 0, 10 ) );
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(bob),   0, 20 ) );
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(carol), 0, 5 ) );
+   produce_blocks();
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(alice), 0, 15 ) );
+
+   //one row per pledger, the latest save id is kept for the allot memo
+   auto pending = get_apl_pending( N(alice) );
+   BOOST_REQUIRE( !pending.is_null() );
+   BOOST_REQUIRE_EQUAL( asset::from_string("25.0000 APL"), pending["apples"].as<asset>() );
+   BOOST_REQUIRE_EQUAL( 3u, pending["last_save_id"].as<uint64_t>() );
+   BOOST_REQUIRE_EQUAL( asset::from_string("20.0000 APL"), get_apl_pending( N(bob) )["apples"].as<asset>() );
+   BOOST_REQUIRE_EQUAL( asset::from_string("5.0000 APL"), get_apl_pending( N(carol) )["apples"].as<asset>() );
+   BOOST_REQUIRE( get_apl_pending( N(parent1) ).is_null() );
+
+   auto cache = get_singleton( SAVETWO, N(farmcache) );
+   BOOST_REQUIRE_EQUAL( asset::from_string("50.0000 APL"), cache["pending_apples"].as<asset>() );
+   BOOST_REQUIRE_EQUAL( asset::from_string("950.0000 APL"), cache["available_apples"].as<asset>() );
+
+   //nothing alloted by the pledges themselves
+   BOOST_REQUIRE_EQUAL( asset::from_string("0.0000 APL"), get_lease( LEASE_ID )["alloted_apples"].as<asset>() );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( apl_pending_kept_beyond_farm_balance, amax_savetwo_tester ) try {
+   open_farm_lease( asset::from_string("15.0000 APL") );
+   BOOST_REQUIRE_EQUAL( success(), createplan( 30, asset::from_string("0.10000000 AMAX"), 1000, asset::from_string("1.0000 APL") ) );
+   produce_blocks();
+
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(alice), 0, 10 ) );
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(bob), 0, 10 ) );
+
+   //bob's apples exceed the cached availability but stay pending
+   BOOST_REQUIRE_EQUAL( asset::from_string("10.0000 APL"), get_apl_pending( N(bob) )["apples"].as<asset>() );
+   BOOST_REQUIRE_EQUAL( asset::from_string("0.0000 APL"), get_singleton( SAVETWO, N(farmcache) )["available_apples"].as<asset>() );
+   BOOST_REQUIRE_EQUAL( asset::from_string("20.0000 APL"), get_singleton( SAVETWO, N(farmcache) )["pending_apples"].as<asset>() );
+
+   //the farm affords 15, the rest waits for a refill
+   BOOST_REQUIRE_EQUAL( success(), flushapl( 10 ) );
+   BOOST_REQUIRE( get_apl_pending( N(alice) ).is_null() );
+   BOOST_REQUIRE_EQUAL( asset::from_string("5.0000 APL"), get_apl_pending( N(bob) )["apples"].as<asset>() );
+   BOOST_REQUIRE_EQUAL( asset::from_string("15.0000 APL"), get_lease( LEASE_ID )["alloted_apples"].as<asset>() );
+
+   issue( APLINK_BANK, APLINK_BANK, APLINK_BANK, asset::from_string("5.0000 APL") );
+   BOOST_REQUIRE_EQUAL( success(), transfer( APLINK_BANK, APLINK_BANK, APLINK_FARM, asset::from_string("5.0000 APL"), to_string(LEASE_ID) ) );
+   produce_blocks();
+   BOOST_REQUIRE_EQUAL( success(), flushapl( 10 ) );
+   BOOST_REQUIRE( get_apl_pending( N(bob) ).is_null() );
+   BOOST_REQUIRE_EQUAL( asset::from_string("20.0000 APL"), get_lease( LEASE_ID )["alloted_apples"].as<asset>() );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( flushapl_allots_in_batches, amax_savetwo_tester ) try {
+   open_farm_lease( asset::from_string("1000.0000 APL") );
+   BOOST_REQUIRE_EQUAL( success(), createplan( 30, asset::from_string("0.10000000 AMAX"), 1000, asset::from_string("1.0000 APL") ) );
+   produce_blocks();
+
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("[[10004]] no pending apl to allot"), flushapl( 10 ) );
+
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(alice), 0, 10 ) );
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(bob),   0, 20 ) );
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(carol), 0, 5 ) );
+   produce_blocks();
+
+   BOOST_REQUIRE_EQUAL( success(), flushapl( 2 ) );
+   BOOST_REQUIRE( get_apl_pending( N(alice) ).is_null() );
+   BOOST_REQUIRE( get_apl_pending( N(bob) ).is_null() );
+   BOOST_REQUIRE( !get_apl_pending( N(carol) ).is_null() );
+   BOOST_REQUIRE_EQUAL( asset::from_string("30.0000 APL"), get_lease( LEASE_ID )["alloted_apples"].as<asset>() );
+   BOOST_REQUIRE_EQUAL( asset::from_string("5.0000 APL"), get_singleton( SAVETWO, N(farmcache) )["pending_apples"].as<asset>() );
+
+   BOOST_REQUIRE_EQUAL( success(), flushapl( 10 ) );
+   BOOST_REQUIRE( get_apl_pending( N(carol) ).is_null() );
+   BOOST_REQUIRE_EQUAL( asset::from_string("35.0000 APL"), get_lease( LEASE_ID )["alloted_apples"].as<asset>() );
+   BOOST_REQUIRE_EQUAL( asset::from_string("0.0000 APL"), get_singleton( SAVETWO, N(farmcache) )["pending_apples"].as<asset>() );
+
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("[[10004]] no pending apl to allot"), flushapl( 10 ) );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( save_account_compact_row, amax_savetwo_tester ) try {
+   BOOST_REQUIRE_EQUAL( success(), createplan( 30, asset::from_string("0.10000000 AMAX"), 1000, asset::from_string("0.0000 APL") ) );
+   BOOST_REQUIRE_EQUAL( success(), refuel( 0, asset::from_string("100.00000000 AMAX") ) );
+   produce_blocks();
+
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(alice), 0, 10 ) );
+   produce_blocks();
+
+   auto acct = get_save_acct( N(alice), 0 );
+   BOOST_REQUIRE( !acct.is_null() );
+   BOOST_REQUIRE_EQUAL( 0u, acct["plan_id"].as<uint64_t>() );
+   BOOST_REQUIRE_EQUAL( 1000000000ll, acct["pledged"].as<int64_t>() );
+   BOOST_REQUIRE_EQUAL( 10u, acct["quotas"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( 100000000ll, acct["interest_alloted"].as<int64_t>() );
+   BOOST_REQUIRE_EQUAL( 0ll, acct["interest_collected"].as<int64_t>() );
+   BOOST_REQUIRE_EQUAL( 30u, acct["term_days"].as<uint16_t>() );
+   BOOST_REQUIRE_EQUAL( 0u, acct["collected_secs"].as<uint32_t>() );
+   BOOST_REQUIRE( get_rows( SAVETWO, N(alice).to_uint64_t(), N(saveaccounts) ).empty() );
+
+   auto index = get_save_index( 0 );
+   BOOST_REQUIRE_EQUAL( N(alice), index["owner"].as<name>() );
+   auto acct_created_at = acct["created_at"].as<time_point_sec>().sec_since_epoch();
+   BOOST_REQUIRE_EQUAL( acct_created_at + 30 * DAY_SECONDS, index["term_ended_at"].as<time_point_sec>().sec_since_epoch() );
+
+   //last_collected_at is kept as seconds past created_at
+   produce_days( 2 );
+   BOOST_REQUIRE_EQUAL( success(), collectint( N(alice), 0 ) );
+   acct = get_save_acct( N(alice), 0 );
+   BOOST_REQUIRE( acct["collected_secs"].as<uint32_t>() >= 2 * DAY_SECONDS );
+   BOOST_REQUIRE( acct_created_at + acct["collected_secs"].as<uint32_t>() <= now() + 1 );
+   BOOST_REQUIRE( acct["interest_collected"].as<int64_t>() > 0 );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( migrate_without_legacy_rows, amax_savetwo_tester ) try {
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("[[10101]] max_rows must be greater than 0"), migrate( N(alice), 0, 0 ) );
+   BOOST_REQUIRE_EQUAL( error("missing authority of armoniaadmin"),
+      push_action( SAVETWO, N(alice), N(migrate), mvo()("owner", N(alice))("cursor", 0)("max_rows", 10) ) );
+
+   BOOST_REQUIRE_EQUAL( success(), createplan( 30, asset::from_string("0.10000000 AMAX"), 1000, asset::from_string("0.0000 APL") ) );
+   produce_blocks();
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(alice), 0, 10 ) );
+   produce_blocks();
+
+   //compact rows are left alone
+   BOOST_REQUIRE_EQUAL( success(), migrate( N(alice), 0, 10 ) );
+   BOOST_REQUIRE( !get_save_acct( N(alice), 0 ).is_null() );
+   BOOST_REQUIRE_EQUAL( 1u, get_rows( SAVETWO, N(alice).to_uint64_t(), N(saveaccts) ).size() );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( plan_conf_and_state_split, amax_savetwo_tester ) try {
+   BOOST_REQUIRE_EQUAL( success(), createplan( 30, asset::from_string("0.10000000 AMAX"), 1000, asset::from_string("0.0000 APL") ) );
+   produce_blocks();
+
+   auto conf = get_plan_conf( 0 );
+   BOOST_REQUIRE( !conf.is_null() );
+   BOOST_REQUIRE_EQUAL( 30u, conf["plan_days"].as<uint16_t>() );
+   BOOST_REQUIRE_EQUAL( 1000u, conf["total_quotas"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( 0u, get_plan_state( 0 )["quotas_purchased"].as<uint32_t>() );
+   BOOST_REQUIRE( get_rows( SAVETWO, SAVETWO.to_uint64_t(), N(saveplan) ).empty() );
+
+   //pledges and refuels only touch the state row
+   BOOST_REQUIRE_EQUAL( success(), refuel( 0, asset::from_string("100.00000000 AMAX") ) );
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(alice), 0, 10 ) );
+   produce_blocks();
+   auto state = get_plan_state( 0 );
+   BOOST_REQUIRE_EQUAL( 10u, state["quotas_purchased"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( 10000000000ll, state["interest_total"].as<int64_t>() );
+   BOOST_REQUIRE_EQUAL( 1000u, get_plan_conf( 0 )["total_quotas"].as<uint32_t>() );
+
+   BOOST_REQUIRE_EQUAL( success(), push_action( SAVETWO, ADMIN, N(setstatus), mvo()("plan_id", 0)("status", "suspended") ) );
+   BOOST_REQUIRE_EQUAL( name("suspended"), get_plan_state( 0 )["status"].as<name>() );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("[[10301]] temporarily suspended"), pledge( N(bob), 0, 10 ) );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( migrateplan_without_legacy_plan, amax_savetwo_tester ) try {
+   BOOST_REQUIRE_EQUAL( success(), createplan( 30, asset::from_string("0.10000000 AMAX"), 1000, asset::from_string("0.0000 APL") ) );
+   produce_blocks();
+
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("[[10008]] plan already migrated: 0"), migrateplan( 0 ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("[[10009]] legacy plan not found: 7"), migrateplan( 7 ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("[[10009]] plan not found: 7"), pledge( N(alice), 7, 10 ) );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( crank_collects_and_redeems_matured_positions, amax_savetwo_tester ) try {
+   BOOST_REQUIRE_EQUAL( success(), createplan( 1, asset::from_string("0.10000000 AMAX"), 1000, asset::from_string("0.0000 APL") ) );
+   BOOST_REQUIRE_EQUAL( success(), refuel( 0, asset::from_string("100.00000000 AMAX") ) );
+   produce_blocks();
+
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(alice), 0, 10 ) );
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(alice), 0, 10 ) );
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(bob),   0, 10 ) );
+   produce_days( 2 );
+
+   BOOST_REQUIRE_EQUAL( error("missing authority of armoniaadmin"),
+      push_action( SAVETWO, N(alice), N(crank), mvo()("plan_id", 0)("cursor", 0)("max_rows", 10) ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("[[10101]] max_rows must be greater than 0"), crank( 0, 0, 0 ) );
+
+   //one position per action, the cursor is the next save id + 1
+   BOOST_REQUIRE_EQUAL( success(), crank( 0, 0, 1 ) );
+   BOOST_REQUIRE( get_save_acct( N(alice), 0 ).is_null() );
+   BOOST_REQUIRE( get_save_index( 0 ).is_null() );
+   BOOST_REQUIRE( !get_save_acct( N(alice), 1 ).is_null() );
+   BOOST_REQUIRE_EQUAL( 2u, get_row( SAVETWO, SAVETWO.to_uint64_t(), N(plancrank), 0 )["next_cursor"].as<uint64_t>() );
+   BOOST_REQUIRE_EQUAL( asset::from_string("99991.00000000 AMAX"), get_amax_balance( N(alice) ) );
+
+   BOOST_REQUIRE_EQUAL( success(), crank( 0, 2, 10 ) );
+   BOOST_REQUIRE( get_rows( SAVETWO, N(alice).to_uint64_t(), N(saveaccts) ).empty() );
+   BOOST_REQUIRE( get_rows( SAVETWO, N(bob).to_uint64_t(), N(saveaccts) ).empty() );
+   BOOST_REQUIRE( get_rows( SAVETWO, SAVETWO.to_uint64_t(), N(saveindex) ).empty() );
+   BOOST_REQUIRE_EQUAL( 0u, get_row( SAVETWO, SAVETWO.to_uint64_t(), N(plancrank), 0 )["next_cursor"].as<uint64_t>() );
+
+   //principal plus interest, transferred once per owner and action
+   BOOST_REQUIRE_EQUAL( asset::from_string("100002.00000000 AMAX"), get_amax_balance( N(alice) ) );
+   BOOST_REQUIRE_EQUAL( asset::from_string("100001.00000000 AMAX"), get_amax_balance( N(bob) ) );
+
+   auto state = get_plan_state( 0 );
+   BOOST_REQUIRE_EQUAL( 0u, state["active_positions"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( 0ll, state["pledged_total"].as<int64_t>() );
+   BOOST_REQUIRE_EQUAL( 300000000ll, state["interest_collected"].as<int64_t>() );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( crank_collects_interest_before_term_end, amax_savetwo_tester ) try {
+   BOOST_REQUIRE_EQUAL( success(), createplan( 30, asset::from_string("0.10000000 AMAX"), 1000, asset::from_string("0.0000 APL") ) );
+   BOOST_REQUIRE_EQUAL( success(), refuel( 0, asset::from_string("100.00000000 AMAX") ) );
+   produce_blocks();
+
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(alice), 0, 10 ) );
+   produce_days( 3 );
+
+   BOOST_REQUIRE_EQUAL( success(), crank( 0, 0, 10 ) );
+   auto acct = get_save_acct( N(alice), 0 );
+   BOOST_REQUIRE( !acct.is_null() );
+   BOOST_REQUIRE( acct["interest_collected"].as<int64_t>() > 0 );
+   BOOST_REQUIRE( acct["interest_collected"].as<int64_t>() < acct["interest_alloted"].as<int64_t>() );
+   BOOST_REQUIRE( !get_save_index( 0 ).is_null() );
+   BOOST_REQUIRE_EQUAL( 0u, get_row( SAVETWO, SAVETWO.to_uint64_t(), N(plancrank), 0 )["next_cursor"].as<uint64_t>() );
+   BOOST_REQUIRE_EQUAL( asset( 9999000000000ll + acct["interest_collected"].as<int64_t>(), symbol(8, "AMAX") ),
+                        get_amax_balance( N(alice) ) );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( plan_tvl_and_daily_stats, amax_savetwo_tester ) try {
+   BOOST_REQUIRE_EQUAL( success(), createplan( 30, asset::from_string("0.10000000 AMAX"), 1000, asset::from_string("0.0000 APL") ) );
+   BOOST_REQUIRE_EQUAL( success(), refuel( 0, asset::from_string("100.00000000 AMAX") ) );
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(alice), 0, 10 ) );
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(bob),   0, 20 ) );
+   produce_blocks();
+
+   auto first_day = today();
+   auto state = get_plan_state( 0 );
+   BOOST_REQUIRE_EQUAL( 3000000000ll, state["pledged_total"].as<int64_t>() );
+   BOOST_REQUIRE_EQUAL( 300000000ll, state["interest_alloted"].as<int64_t>() );
+   BOOST_REQUIRE_EQUAL( 2u, state["active_positions"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( first_day, state["stats_day"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( 3000000000ll, state["day_pledged"].as<int64_t>() );
+   BOOST_REQUIRE( get_rows( SAVETWO, 0, N(dailystats) ).empty() );
+
+   //the first action of a later day closes every day since, idle days get zero inflow
+   produce_days( 3 );
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(carol), 0, 5 ) );
+   produce_blocks();
+
+   auto rows = get_rows( SAVETWO, 0, N(dailystats) );
+   BOOST_REQUIRE_EQUAL( today() - first_day, rows.size() );
+   for (uint32_t i = 0; i < rows.size(); i++) {
+      BOOST_REQUIRE_EQUAL( first_day + i, rows[i]["day"].as<uint32_t>() );
+      BOOST_REQUIRE_EQUAL( 3000000000ll, rows[i]["pledged_total"].as<int64_t>() );
+      BOOST_REQUIRE_EQUAL( 2u, rows[i]["active_positions"].as<uint32_t>() );
+      BOOST_REQUIRE_EQUAL( i == 0 ? 3000000000ll : 0ll, rows[i]["day_pledged"].as<int64_t>() );
+   }
+
+   state = get_plan_state( 0 );
+   BOOST_REQUIRE_EQUAL( today(), state["stats_day"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( 3500000000ll, state["pledged_total"].as<int64_t>() );
+   BOOST_REQUIRE_EQUAL( 500000000ll, state["day_pledged"].as<int64_t>() );
+   BOOST_REQUIRE_EQUAL( 3u, state["active_positions"].as<uint32_t>() );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( daily_stats_gap_is_capped, amax_savetwo_tester ) try {
+   BOOST_REQUIRE_EQUAL( success(), createplan( 90, asset::from_string("0.10000000 AMAX"), 1000, asset::from_string("0.0000 APL") ) );
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(alice), 0, 10 ) );
+   produce_blocks();
+
+   auto first_day = today();
+   produce_days( 40 );
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(bob), 0, 10 ) );
+   produce_blocks();
+
+   auto rows = get_rows( SAVETWO, 0, N(dailystats) );
+   BOOST_REQUIRE_EQUAL( 31u, rows.size() );
+   BOOST_REQUIRE_EQUAL( first_day, rows.front()["day"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( first_day + 30, rows.back()["day"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( today(), get_plan_state( 0 )["stats_day"].as<uint32_t>() );
+} FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_SUITE_END()
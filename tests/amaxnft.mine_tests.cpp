@@ -0,0 +1,527 @@
+#include "apollo_tester.hpp"
+
+static const uint128_t PRE_INTEREST_SCALE = 1'000'000'000'000'000'000ull;
+
+class amaxnft_mine_tester : public apollo_tester {
+public:
+   const name NFT_MINE  = N(amaxnft.mine);
+   const name SYS_BANK  = N(amax.token);
+   const name NFT_BANK  = N(amax.ntoken);
+   const name ADMIN     = N(nftone.admin);
+   const name SPONSOR   = N(sponsor);
+
+   amaxnft_mine_tester() {
+      produce_blocks( 2 );
+
+      create_accounts( { SYS_BANK, NFT_BANK, NFT_MINE, ADMIN, SPONSOR, N(alice), N(bob) } );
+      produce_blocks( 2 );
+
+      deploy_contract( SYS_BANK, contracts::deps::token_wasm(),  contracts::deps::token_abi() );
+      deploy_contract( NFT_BANK, contracts::deps::ntoken_wasm(), contracts::deps::ntoken_abi() );
+      deploy_contract( NFT_MINE, contracts::amaxnft_mine_wasm(), contracts::amaxnft_mine_abi() );
+      produce_blocks();
+
+      create_currency( SYS_BANK, SYS_BANK, asset::from_string("10000000000.00000000 AMAX") );
+      issue( SYS_BANK, SYS_BANK, SPONSOR, asset::from_string("100000.00000000 AMAX") );
+
+      //ntokens 1..3 without a collection, 101 and 102 of collection 100
+      for (uint32_t id = 1; id <= 3; id++) {
+         create_ntoken( NFT_BANK, NFT_BANK, 1000, id );
+         issue_ntoken( NFT_BANK, NFT_BANK, N(alice), nasset( 100, id ) );
+         issue_ntoken( NFT_BANK, NFT_BANK, N(bob), nasset( 100, id ) );
+      }
+      for (uint32_t id = 101; id <= 102; id++) {
+         create_ntoken( NFT_BANK, NFT_BANK, 1000, id, 100 );
+         issue_ntoken( NFT_BANK, NFT_BANK, N(alice), nasset( 100, id, 100 ) );
+      }
+
+      BOOST_REQUIRE_EQUAL( success(), push_action( NFT_MINE, NFT_MINE, N(init), mvo()
+         ("ntoken_contract", vector<name>{ NFT_BANK })
+         ("profit_token_contract", vector<name>{ SYS_BANK })
+         ("nft_size_limit", 50)
+         ("plan_size_limit", 1)
+         ("campaign_create_fee", asset::from_string("5.00000000 AMAX"))
+      ));
+      produce_blocks();
+   }
+
+   //pays the creation fee, the campaign is INIT until setcampaign
+   uint64_t pay_campaign_fee() {
+      auto campaign_id = get_singleton( NFT_MINE, N(global) )["last_campaign_id"].as<uint64_t>();
+      BOOST_REQUIRE_EQUAL( success(), transfer( SYS_BANK, SPONSOR, NFT_MINE, asset::from_string("5.00000000 AMAX"), "create_campaign" ) );
+      return campaign_id;
+   }
+
+   action_result setcampaign( const uint64_t& campaign_id, const vector<uint64_t>& nftids, const uint16_t& plan_day,
+                              const uint32_t& total_quotas, const uint32_t& begin_at, const uint32_t& end_at ) {
+      return push_action( NFT_MINE, SPONSOR, N(setcampaign), mvo()
+         ("sponsor", SPONSOR)
+         ("campaign_id", campaign_id)
+         ("nftids", nftids)
+         ("plan_day", plan_day)
+         ("plan_interest", asset::from_string("0.01000000 AMAX"))
+         ("ntoken_contract", NFT_BANK)
+         ("total_quotas", total_quotas)
+         ("campaign_name_cn", "campaign")
+         ("campaign_name_en", "campaign")
+         ("campaign_pic_url_cn", "https://pic")
+         ("campaign_pic_url_en", "https://pic")
+         ("begin_at", begin_at)
+         ("end_at", end_at)
+      );
+   }
+
+   //campaign over ntokens 1 and 2, open from now on for 60 days
+   uint64_t create_campaign( const uint16_t& plan_day, const uint32_t& total_quotas ) {
+      auto campaign_id = pay_campaign_fee();
+      BOOST_REQUIRE_EQUAL( success(), setcampaign( campaign_id, { 1, 2 }, plan_day, total_quotas, now(), now() + 60 * DAY_SECONDS ) );
+      return campaign_id;
+   }
+
+   action_result pledge( const name& from, const uint64_t& campaign_id, const fc::variant& quantity ) {
+      return transfer_ntokens( NFT_BANK, from, NFT_MINE, { quantity }, "pledge:" + to_string(campaign_id) );
+   }
+
+   action_result refuelint( const uint64_t& campaign_id, const asset& quantity ) {
+      return transfer( SYS_BANK, SPONSOR, NFT_MINE, quantity, "refuelint:" + to_string(campaign_id) );
+   }
+
+   action_result refuelsched( const uint64_t& campaign_id, const asset& quantity, const uint32_t& start_at, const uint32_t& end_at ) {
+      return transfer( SYS_BANK, SPONSOR, NFT_MINE, quantity,
+                       "refuelsched:" + to_string(campaign_id) + ":" + to_string(start_at) + ":" + to_string(end_at) );
+   }
+
+   action_result collectint( const name& owner, const uint64_t& save_id ) {
+      return push_action( NFT_MINE, owner, N(collectint), mvo()("issuer", owner)("owner", owner)("save_id", save_id) );
+   }
+
+   action_result setcampparent( const uint64_t& campaign_id, const uint32_t& parent_id ) {
+      return push_action( NFT_MINE, SPONSOR, N(setcampparent), mvo()
+         ("sponsor", SPONSOR)
+         ("campaign_id", campaign_id)
+         ("ntoken_contract", NFT_BANK)
+         ("parent_id", parent_id)
+      );
+   }
+
+   action_result redeem( const name& owner, const uint64_t& save_id ) {
+      return push_action( NFT_MINE, owner, N(redeem), mvo()("issuer", owner)("owner", owner)("save_id", save_id) );
+   }
+
+   fc::variant get_campaign( const uint64_t& campaign_id ) {
+      return get_row( NFT_MINE, NFT_MINE.to_uint64_t(), N(campstate), campaign_id );
+   }
+
+   fc::variant get_mine_acct( const name& owner, const uint64_t& save_id ) {
+      return get_row( NFT_MINE, owner.to_uint64_t(), N(mineaccounts), save_id );
+   }
+
+   uint128_t get_pre_interest( const uint64_t& campaign_id ) {
+      return get_campaign( campaign_id )["pre_interest_acc"].as<uint128_t>();
+   }
+
+   asset get_amax_balance( const name& owner ) {
+      return get_balance( SYS_BANK, owner, symbol(8, "AMAX") );
+   }
+};
+
+BOOST_AUTO_TEST_SUITE(amaxnft_mine_tests)
+
+BOOST_FIXTURE_TEST_CASE( refuel_spreads_with_scaled_accumulator, amaxnft_mine_tester ) try {
+   auto campaign_id = create_campaign( 1, 100 );
+   produce_blocks();
+
+   //default pre interest is 1 AMAX per quota, scaled
+   uint128_t start_acc = (uint128_t)100000000 * PRE_INTEREST_SCALE;
+   BOOST_REQUIRE( start_acc == get_pre_interest( campaign_id ) );
+
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("[[10003]] purchase quotas must be greater than 0"),
+                        refuelint( campaign_id, asset::from_string("1.00000000 AMAX") ) );
+
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(alice), campaign_id, nasset( 1, 1 ) ) );
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(bob), campaign_id, nasset( 2, 2 ) ) );
+   BOOST_REQUIRE( get_mine_acct( N(alice), 1 )["save_pre_interest_acc"].as<uint128_t>() == start_acc );
+   BOOST_REQUIRE_EQUAL( 3u, get_campaign( campaign_id )["quotas_purchased"].as<uint32_t>() );
+
+   //1 AMAX over 3 quotas leaves a remainder of 1 scaled unit
+   BOOST_REQUIRE_EQUAL( success(), refuelint( campaign_id, asset::from_string("1.00000000 AMAX") ) );
+   auto campaign = get_campaign( campaign_id );
+   BOOST_REQUIRE( get_pre_interest( campaign_id ) - start_acc == (uint128_t)100000000 * PRE_INTEREST_SCALE / 3 );
+   BOOST_REQUIRE( campaign["pre_interest_rem"].as<uint128_t>() == 1 );
+   BOOST_REQUIRE_EQUAL( name("append"), campaign["status"].as<name>() );
+   BOOST_REQUIRE_EQUAL( asset::from_string("1.00000000 AMAX"), campaign["interest_total"].as<asset>() );
+
+   //the remainder is carried into the next refuel, which divides evenly
+   BOOST_REQUIRE_EQUAL( success(), refuelint( campaign_id, asset::from_string("0.00000002 AMAX") ) );
+   BOOST_REQUIRE( get_campaign( campaign_id )["pre_interest_rem"].as<uint128_t>() == 0 );
+   produce_blocks();
+
+   BOOST_REQUIRE_EQUAL( success(), collectint( N(alice), 1 ) );
+   BOOST_REQUIRE_EQUAL( success(), collectint( N(bob), 2 ) );
+   BOOST_REQUIRE_EQUAL( asset::from_string("0.33333334 AMAX"), get_amax_balance( N(alice) ) );
+   BOOST_REQUIRE_EQUAL( asset::from_string("0.66666668 AMAX"), get_amax_balance( N(bob) ) );
+   BOOST_REQUIRE_EQUAL( asset::from_string("1.00000002 AMAX"), get_campaign( campaign_id )["interest_collected"].as<asset>() );
+   BOOST_REQUIRE_EQUAL( asset::from_string("0.33333334 AMAX"), get_mine_acct( N(alice), 1 )["interest_collected"].as<asset>() );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( collect_rejects_zero_and_early_collects, amaxnft_mine_tester ) try {
+   auto campaign_id = create_campaign( 1, 100 );
+   produce_blocks();
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(alice), campaign_id, nasset( 1, 1 ) ) );
+   produce_blocks();
+
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("[[10004]] interest due amount is zero"), collectint( N(alice), 1 ) );
+
+   BOOST_REQUIRE_EQUAL( success(), refuelint( campaign_id, asset::from_string("1.00000000 AMAX") ) );
+   BOOST_REQUIRE_EQUAL( success(), collectint( N(alice), 1 ) );
+   BOOST_REQUIRE_EQUAL( asset::from_string("1.00000000 AMAX"), get_amax_balance( N(alice) ) );
+
+   //a later pledger only earns what is refueled after its pledge
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(bob), campaign_id, nasset( 1, 2 ) ) );
+   produce_blocks();
+   BOOST_REQUIRE_EQUAL( success(), refuelint( campaign_id, asset::from_string("1.00000000 AMAX") ) );
+   produce_blocks();
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("[[3]] term not ended"), collectint( N(alice), 1 ) );
+   BOOST_REQUIRE_EQUAL( success(), collectint( N(bob), 2 ) );
+   BOOST_REQUIRE_EQUAL( asset::from_string("0.50000000 AMAX"), get_amax_balance( N(bob) ) );
+
+   produce_days( 1 );
+   BOOST_REQUIRE_EQUAL( success(), collectint( N(alice), 1 ) );
+   BOOST_REQUIRE_EQUAL( asset::from_string("1.50000000 AMAX"), get_amax_balance( N(alice) ) );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( campaign_accepts_whole_collection, amaxnft_mine_tester ) try {
+   auto campaign_id = pay_campaign_fee();
+
+   //a campaign needs nft ids or a collection
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("[[10101]] nft size is zero"),
+                        setcampaign( campaign_id, {}, 1, 100, now(), now() + 60 * DAY_SECONDS ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("[[10009]] nft parent not found: 200"), setcampparent( campaign_id, 200 ) );
+   BOOST_REQUIRE_EQUAL( error("missing authority of sponsor"),
+      push_action( NFT_MINE, N(alice), N(setcampparent), mvo()
+         ("sponsor", SPONSOR)("campaign_id", campaign_id)("ntoken_contract", NFT_BANK)("parent_id", 100) ) );
+
+   BOOST_REQUIRE_EQUAL( success(), setcampparent( campaign_id, 100 ) );
+   BOOST_REQUIRE_EQUAL( success(), setcampaign( campaign_id, {}, 1, 100, now(), now() + 60 * DAY_SECONDS ) );
+   BOOST_REQUIRE( get_rows( NFT_MINE, campaign_id, N(campntokens) ).empty() );
+   produce_blocks();
+
+   //any nft of the collection is accepted, others are not
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(alice), campaign_id, nasset( 1, 101, 100 ) ) );
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(alice), campaign_id, nasset( 2, 102, 100 ) ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("[[10101]] this ntoken does not exist"), pledge( N(alice), campaign_id, nasset( 1, 1 ) ) );
+
+   auto parent = get_row( NFT_MINE, NFT_MINE.to_uint64_t(), N(campparent), campaign_id );
+   BOOST_REQUIRE_EQUAL( NFT_BANK, parent["ntoken_contract"].as<name>() );
+   BOOST_REQUIRE_EQUAL( 100u, parent["parent_id"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( 3u, parent["quota"]["allocated_quotas"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( 3u, get_campaign( campaign_id )["quotas_purchased"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( 100u, get_mine_acct( N(alice), 2 )["pledged"]["quantity"]["symbol"]["parent_id"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( 98, get_ntoken_balance( NFT_BANK, N(alice), 102, 100 ) );
+
+   //the collection is locked while pledged
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("[[10]] collection already pledged"), setcampparent( campaign_id, 100 ) );
+
+   produce_days( 2 );
+   BOOST_REQUIRE_EQUAL( success(), redeem( N(alice), 1 ) );
+   BOOST_REQUIRE_EQUAL( success(), redeem( N(alice), 2 ) );
+   parent = get_row( NFT_MINE, NFT_MINE.to_uint64_t(), N(campparent), campaign_id );
+   BOOST_REQUIRE_EQUAL( 3u, parent["quota"]["redeemed_quotas"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( 100, get_ntoken_balance( NFT_BANK, N(alice), 102, 100 ) );
+   BOOST_REQUIRE_EQUAL( success(), setcampparent( campaign_id, 100 ) );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( campaign_with_ids_and_collection, amaxnft_mine_tester ) try {
+   auto campaign_id = pay_campaign_fee();
+   BOOST_REQUIRE_EQUAL( success(), setcampparent( campaign_id, 100 ) );
+   BOOST_REQUIRE_EQUAL( success(), setcampaign( campaign_id, { 1 }, 1, 3, now(), now() + 60 * DAY_SECONDS ) );
+   produce_blocks();
+
+   //listed ids and the collection share the campaign quotas
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(alice), campaign_id, nasset( 1, 1 ) ) );
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(alice), campaign_id, nasset( 1, 101, 100 ) ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("[[1]] quotas insufficient"), pledge( N(alice), campaign_id, nasset( 2, 102, 100 ) ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("[[10101]] this ntoken does not exist"), pledge( N(bob), campaign_id, nasset( 1, 2 ) ) );
+
+   BOOST_REQUIRE_EQUAL( 1u, get_row( NFT_MINE, campaign_id, N(campntokens), 1 )["quota"]["allocated_quotas"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( 1u, get_row( NFT_MINE, NFT_MINE.to_uint64_t(), N(campparent), campaign_id )["quota"]["allocated_quotas"].as<uint32_t>() );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( campaign_state_meta_and_ntoken_rows, amaxnft_mine_tester ) try {
+   auto campaign_id = pay_campaign_fee();
+   auto campaign = get_campaign( campaign_id );
+   BOOST_REQUIRE_EQUAL( name("init"), campaign["status"].as<name>() );
+   BOOST_REQUIRE_EQUAL( SPONSOR, campaign["sponsor"].as<name>() );
+   BOOST_REQUIRE( get_row( NFT_MINE, NFT_MINE.to_uint64_t(), N(campmeta), campaign_id ).is_null() );
+
+   //starts tomorrow so it can still be cancelled
+   BOOST_REQUIRE_EQUAL( success(), setcampaign( campaign_id, { 1, 2 }, 1, 100, now() + DAY_SECONDS, now() + 60 * DAY_SECONDS ) );
+   campaign = get_campaign( campaign_id );
+   BOOST_REQUIRE_EQUAL( name("created"), campaign["status"].as<name>() );
+   BOOST_REQUIRE_EQUAL( 100u, campaign["total_quotas"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( asset::from_string("0.01000000 AMAX"), campaign["plan_interest"].as<asset>() );
+
+   auto meta = get_row( NFT_MINE, NFT_MINE.to_uint64_t(), N(campmeta), campaign_id );
+   BOOST_REQUIRE_EQUAL( "campaign", meta["campaign_name_cn"].as<string>() );
+   BOOST_REQUIRE_EQUAL( "https://pic", meta["campaign_pic_url_en"].as<string>() );
+
+   auto ntokens = get_rows( NFT_MINE, campaign_id, N(campntokens) );
+   BOOST_REQUIRE_EQUAL( 2u, ntokens.size() );
+   BOOST_REQUIRE_EQUAL( 1u, ntokens[0]["symbol"]["sym"]["id"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( 0u, ntokens[0]["quota"]["allocated_quotas"].as<uint32_t>() );
+   BOOST_REQUIRE( get_rows( NFT_MINE, NFT_MINE.to_uint64_t(), N(minecampaign) ).empty() );
+
+   //ids already listed are kept, new ones appended
+   BOOST_REQUIRE_EQUAL( success(), setcampaign( campaign_id, { 2, 3 }, 1, 100, now() + DAY_SECONDS, now() + 60 * DAY_SECONDS ) );
+   BOOST_REQUIRE_EQUAL( 3u, get_rows( NFT_MINE, campaign_id, N(campntokens) ).size() );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("[[10101]] quotas cannot be less than the original"),
+                        setcampaign( campaign_id, { 1 }, 1, 99, now() + DAY_SECONDS, now() + 60 * DAY_SECONDS ) );
+
+   //cancelling removes the state row and its children
+   BOOST_REQUIRE_EQUAL( success(), push_action( NFT_MINE, SPONSOR, N(cancelcamp), mvo()
+      ("issuer", SPONSOR)("owner", SPONSOR)("campaign_id", campaign_id) ) );
+   BOOST_REQUIRE( get_campaign( campaign_id ).is_null() );
+   BOOST_REQUIRE( get_row( NFT_MINE, NFT_MINE.to_uint64_t(), N(campmeta), campaign_id ).is_null() );
+   BOOST_REQUIRE( get_rows( NFT_MINE, campaign_id, N(campntokens) ).empty() );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( pledge_updates_state_and_ntoken_rows_only, amaxnft_mine_tester ) try {
+   auto campaign_id = create_campaign( 1, 100 );
+   produce_blocks();
+
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(alice), campaign_id, nasset( 2, 1 ) ) );
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(bob), campaign_id, nasset( 1, 2 ) ) );
+   BOOST_REQUIRE_EQUAL( 3u, get_campaign( campaign_id )["quotas_purchased"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( 2u, get_row( NFT_MINE, campaign_id, N(campntokens), 1 )["quota"]["allocated_quotas"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( 1u, get_row( NFT_MINE, campaign_id, N(campntokens), 2 )["quota"]["allocated_quotas"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( campaign_id, get_mine_acct( N(alice), 1 )["campaign_id"].as<uint64_t>() );
+
+   BOOST_REQUIRE_EQUAL( success(), push_action( NFT_MINE, SPONSOR, N(setcamptime), mvo()
+      ("sponsor", SPONSOR)("campaign_id", campaign_id)("begin_at", now())("end_at", now() + 90 * DAY_SECONDS) ) );
+   BOOST_REQUIRE_EQUAL( now() + 90 * DAY_SECONDS, get_campaign( campaign_id )["end_at"].as<time_point_sec>().sec_since_epoch() );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("[[10009]] campaign not found: 9"), push_action( NFT_MINE, SPONSOR, N(setcamptime), mvo()
+      ("sponsor", SPONSOR)("campaign_id", 9)("begin_at", now())("end_at", now() + DAY_SECONDS) ) );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( changeaccts_and_changeall_move_positions, amaxnft_mine_tester ) try {
+   auto campaign_id = create_campaign( 1, 100 );
+   produce_blocks();
+   for (int i = 0; i < 4; i++) {
+      BOOST_REQUIRE_EQUAL( success(), pledge( N(alice), campaign_id, nasset( 1, 1 ) ) );
+      produce_blocks();
+   }
+   BOOST_REQUIRE_EQUAL( success(), refuelint( campaign_id, asset::from_string("4.00000000 AMAX") ) );
+   produce_blocks();
+   auto snapshot = get_mine_acct( N(alice), 1 )["save_pre_interest_acc"].as<uint128_t>();
+
+   BOOST_REQUIRE_EQUAL( error("missing authority of amaxnft.mine"), push_action( NFT_MINE, N(alice), N(changeaccts), mvo()
+      ("owner", N(alice))("new_owner", N(bob))("save_ids", vector<uint64_t>{ 1 }) ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("[[10101]] save_ids is empty"), push_action( NFT_MINE, NFT_MINE, N(changeaccts), mvo()
+      ("owner", N(alice))("new_owner", N(bob))("save_ids", vector<uint64_t>{}) ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("[[10009]] account save not found: 9"), push_action( NFT_MINE, NFT_MINE, N(changeaccts), mvo()
+      ("owner", N(alice))("new_owner", N(bob))("save_ids", vector<uint64_t>{ 1, 9 }) ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("[[10101]] owner account is same"), push_action( NFT_MINE, NFT_MINE, N(changeaccts), mvo()
+      ("owner", N(alice))("new_owner", N(alice))("save_ids", vector<uint64_t>{ 1 }) ) );
+
+   //ids and interest snapshots are kept
+   BOOST_REQUIRE_EQUAL( success(), push_action( NFT_MINE, NFT_MINE, N(changeaccts), mvo()
+      ("owner", N(alice))("new_owner", N(bob))("save_ids", vector<uint64_t>{ 1, 2 }) ) );
+   BOOST_REQUIRE( get_mine_acct( N(alice), 1 ).is_null() );
+   BOOST_REQUIRE( get_mine_acct( N(alice), 2 ).is_null() );
+   BOOST_REQUIRE( get_mine_acct( N(bob), 1 )["save_pre_interest_acc"].as<uint128_t>() == snapshot );
+   BOOST_REQUIRE_EQUAL( 2u, get_rows( NFT_MINE, N(alice).to_uint64_t(), N(mineaccounts) ).size() );
+
+   //one row per action, the moved row leaves the scope so cursor 0 resumes
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("[[10101]] max_rows must be greater than 0"), push_action( NFT_MINE, NFT_MINE, N(changeall), mvo()
+      ("owner", N(alice))("new_owner", N(bob))("cursor", 0)("max_rows", 0) ) );
+   BOOST_REQUIRE_EQUAL( success(), push_action( NFT_MINE, NFT_MINE, N(changeall), mvo()
+      ("owner", N(alice))("new_owner", N(bob))("cursor", 0)("max_rows", 1) ) );
+   BOOST_REQUIRE( get_mine_acct( N(alice), 3 ).is_null() );
+   BOOST_REQUIRE( !get_mine_acct( N(alice), 4 ).is_null() );
+   BOOST_REQUIRE_EQUAL( success(), push_action( NFT_MINE, NFT_MINE, N(changeall), mvo()
+      ("owner", N(alice))("new_owner", N(bob))("cursor", 0)("max_rows", 10) ) );
+   BOOST_REQUIRE( get_rows( NFT_MINE, N(alice).to_uint64_t(), N(mineaccounts) ).empty() );
+   BOOST_REQUIRE_EQUAL( 4u, get_rows( NFT_MINE, N(bob).to_uint64_t(), N(mineaccounts) ).size() );
+   produce_blocks();
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("[[10009]] account save not found"), push_action( NFT_MINE, NFT_MINE, N(changeall), mvo()
+      ("owner", N(alice))("new_owner", N(bob))("cursor", 0)("max_rows", 10) ) );
+
+   //the new owner collects what accrued before the move
+   for (uint64_t save_id = 1; save_id <= 4; save_id++)
+      BOOST_REQUIRE_EQUAL( success(), collectint( N(bob), save_id ) );
+   BOOST_REQUIRE_EQUAL( asset::from_string("4.00000000 AMAX"), get_amax_balance( N(bob) ) );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( redeem_collects_due_interest, amaxnft_mine_tester ) try {
+   auto campaign_id = create_campaign( 1, 100 );
+   produce_blocks();
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(alice), campaign_id, nasset( 1, 1 ) ) );
+   BOOST_REQUIRE_EQUAL( success(), refuelint( campaign_id, asset::from_string("1.00000000 AMAX") ) );
+   produce_blocks();
+
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("[[3]] term not ended"), push_action( NFT_MINE, N(alice), N(redeem), mvo()
+      ("issuer", N(alice))("owner", N(alice))("save_id", 1)("collect", true) ) );
+   produce_days( 2 );
+
+   //without collect the due interest must be collected first
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("[[10004]] interest due amount is not zero"), redeem( N(alice), 1 ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("[[10004]] interest due amount is not zero"), push_action( NFT_MINE, N(alice), N(redeem), mvo()
+      ("issuer", N(alice))("owner", N(alice))("save_id", 1)("collect", false) ) );
+
+   BOOST_REQUIRE_EQUAL( success(), push_action( NFT_MINE, N(alice), N(redeem), mvo()
+      ("issuer", N(alice))("owner", N(alice))("save_id", 1)("collect", true) ) );
+   BOOST_REQUIRE( get_mine_acct( N(alice), 1 ).is_null() );
+   BOOST_REQUIRE_EQUAL( 100, get_ntoken_balance( NFT_BANK, N(alice), 1 ) );
+   BOOST_REQUIRE_EQUAL( asset::from_string("1.00000000 AMAX"), get_amax_balance( N(alice) ) );
+
+   auto campaign = get_campaign( campaign_id );
+   BOOST_REQUIRE_EQUAL( 0u, campaign["quotas_purchased"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( asset::from_string("1.00000000 AMAX"), campaign["interest_collected"].as<asset>() );
+   BOOST_REQUIRE_EQUAL( 1u, get_row( NFT_MINE, campaign_id, N(campntokens), 1 )["quota"]["redeemed_quotas"].as<uint32_t>() );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( redeem_collect_without_due_interest, amaxnft_mine_tester ) try {
+   auto campaign_id = create_campaign( 1, 100 );
+   produce_blocks();
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(alice), campaign_id, nasset( 1, 1 ) ) );
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(bob), campaign_id, nasset( 1, 2 ) ) );
+   BOOST_REQUIRE_EQUAL( success(), refuelint( campaign_id, asset::from_string("2.00000000 AMAX") ) );
+   produce_days( 2 );
+
+   //collected positions redeem the same with or without collect
+   BOOST_REQUIRE_EQUAL( success(), collectint( N(alice), 1 ) );
+   BOOST_REQUIRE_EQUAL( success(), push_action( NFT_MINE, N(alice), N(redeem), mvo()
+      ("issuer", N(alice))("owner", N(alice))("save_id", 1)("collect", true) ) );
+   BOOST_REQUIRE_EQUAL( asset::from_string("1.00000000 AMAX"), get_amax_balance( N(alice) ) );
+
+   //others can only be redeemed by the admin
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("[[10001]] non-admin not allowed to redeem others saving account"),
+      push_action( NFT_MINE, N(alice), N(redeem), mvo()("issuer", N(alice))("owner", N(bob))("save_id", 2)("collect", true) ) );
+   BOOST_REQUIRE_EQUAL( success(),
+      push_action( NFT_MINE, ADMIN, N(redeem), mvo()("issuer", ADMIN)("owner", N(bob))("save_id", 2)("collect", true) ) );
+   BOOST_REQUIRE_EQUAL( asset::from_string("1.00000000 AMAX"), get_amax_balance( N(bob) ) );
+   BOOST_REQUIRE_EQUAL( 100, get_ntoken_balance( NFT_BANK, N(bob), 2 ) );
+   BOOST_REQUIRE_EQUAL( asset::from_string("2.00000000 AMAX"), get_campaign( campaign_id )["interest_collected"].as<asset>() );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( refuelsched_releases_linearly, amaxnft_mine_tester ) try {
+   auto campaign_id = create_campaign( 1, 100 );
+   produce_blocks();
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(alice), campaign_id, nasset( 1, 1 ) ) );
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(bob), campaign_id, nasset( 1, 2 ) ) );
+
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("[[10101]] invalid release period"),
+                        refuelsched( campaign_id, asset::from_string("10.00000000 AMAX"), now() - 10, now() + DAY_SECONDS ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("[[10101]] invalid release period"),
+                        refuelsched( campaign_id, asset::from_string("10.00000000 AMAX"), now() + 10, now() + 10 ) );
+
+   uint32_t start_at = now() + 10;
+   BOOST_REQUIRE_EQUAL( success(), refuelsched( campaign_id, asset::from_string("10.00000000 AMAX"), start_at, start_at + 10 * DAY_SECONDS ) );
+   auto campaign = get_campaign( campaign_id );
+   BOOST_REQUIRE_EQUAL( name("append"), campaign["status"].as<name>() );
+   BOOST_REQUIRE_EQUAL( asset::from_string("10.00000000 AMAX"), campaign["interest_total"].as<asset>() );
+   BOOST_REQUIRE_EQUAL( asset::from_string("10.00000000 AMAX"), campaign["release"]["quantity"].as<asset>() );
+   BOOST_REQUIRE_EQUAL( 0, campaign["release"]["released"].as<asset>().get_amount() );
+   produce_blocks();
+
+   //nothing is due before start_at
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("[[10004]] interest due amount is zero"), collectint( N(alice), 1 ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("[[10304]] previous release not finished"),
+                        refuelsched( campaign_id, asset::from_string("1.00000000 AMAX"), now() + 10, now() + DAY_SECONDS ) );
+
+   //half way through, half is released and spread over both quotas
+   produce_block( fc::seconds( 5 * DAY_SECONDS + 10 ) );
+   BOOST_REQUIRE_EQUAL( success(), collectint( N(alice), 1 ) );
+   auto released = get_campaign( campaign_id )["release"]["released"].as<asset>();
+   BOOST_REQUIRE( released.get_amount() >= 5'0000'0000 && released.get_amount() < 6'0000'0000 );
+   BOOST_REQUIRE_EQUAL( asset( released.get_amount() / 2, symbol(8, "AMAX") ), get_amax_balance( N(alice) ) );
+
+   //everything is released by end_at
+   produce_days( 6 );
+   BOOST_REQUIRE_EQUAL( success(), collectint( N(alice), 1 ) );
+   BOOST_REQUIRE_EQUAL( success(), collectint( N(bob), 2 ) );
+   campaign = get_campaign( campaign_id );
+   BOOST_REQUIRE_EQUAL( asset::from_string("10.00000000 AMAX"), campaign["release"]["released"].as<asset>() );
+   BOOST_REQUIRE_EQUAL( 0, campaign["release"]["skipped"].as<asset>().get_amount() );
+   BOOST_REQUIRE_EQUAL( asset::from_string("5.00000000 AMAX"), get_amax_balance( N(alice) ) );
+   BOOST_REQUIRE_EQUAL( asset::from_string("5.00000000 AMAX"), get_amax_balance( N(bob) ) );
+
+   //a finished schedule can be replaced
+   BOOST_REQUIRE_EQUAL( success(), refuelsched( campaign_id, asset::from_string("1.00000000 AMAX"), now() + 10, now() + DAY_SECONDS ) );
+   BOOST_REQUIRE_EQUAL( asset::from_string("1.00000000 AMAX"), get_campaign( campaign_id )["release"]["quantity"].as<asset>() );
+   BOOST_REQUIRE_EQUAL( asset::from_string("11.00000000 AMAX"), get_campaign( campaign_id )["interest_total"].as<asset>() );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( refuelsched_skips_while_nothing_pledged, amaxnft_mine_tester ) try {
+   auto campaign_id = create_campaign( 1, 100 );
+   produce_blocks();
+
+   //a schedule may start before anything is pledged
+   uint32_t start_at = now() + 10;
+   BOOST_REQUIRE_EQUAL( success(), refuelsched( campaign_id, asset::from_string("10.00000000 AMAX"), start_at, start_at + 10 * DAY_SECONDS ) );
+   produce_days( 2 );
+
+   //the first pledger does not capture what was due while nothing was pledged,
+   //it is folded back into the rest of the schedule instead
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(alice), campaign_id, nasset( 1, 1 ) ) );
+   auto campaign = get_campaign( campaign_id );
+   BOOST_REQUIRE_EQUAL( asset::from_string("10.00000000 AMAX"), campaign["release"]["quantity"].as<asset>() );
+   BOOST_REQUIRE_EQUAL( 0, campaign["release"]["released"].as<asset>().get_amount() );
+   BOOST_REQUIRE_EQUAL( 0, campaign["release"]["skipped"].as<asset>().get_amount() );
+   auto resumed_at = campaign["release"]["start_at"].as<time_point_sec>().sec_since_epoch();
+   BOOST_REQUIRE( resumed_at >= now() && resumed_at <= now() + 1 );
+   BOOST_REQUIRE_EQUAL( start_at + 10 * DAY_SECONDS, campaign["release"]["end_at"].as<time_point_sec>().sec_since_epoch() );
+
+   produce_days( 9 );
+   BOOST_REQUIRE_EQUAL( success(), collectint( N(alice), 1 ) );
+   campaign = get_campaign( campaign_id );
+   BOOST_REQUIRE_EQUAL( asset::from_string("10.00000000 AMAX"), campaign["release"]["released"].as<asset>() );
+   BOOST_REQUIRE_EQUAL( asset::from_string("10.00000000 AMAX"), get_amax_balance( N(alice) ) );
+   BOOST_REQUIRE_EQUAL( asset::from_string("10.00000000 AMAX"), campaign["interest_collected"].as<asset>() );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( refuelsched_restarts_ended_schedule_on_resume, amaxnft_mine_tester ) try {
+   auto campaign_id = create_campaign( 1, 100 );
+   produce_blocks();
+
+   uint32_t start_at = now() + 10;
+   BOOST_REQUIRE_EQUAL( success(), refuelsched( campaign_id, asset::from_string("10.00000000 AMAX"), start_at, start_at + DAY_SECONDS ) );
+   produce_days( 2 );
+
+   //the whole schedule ran while nothing was pledged, it runs once more from the first pledge
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(alice), campaign_id, nasset( 1, 1 ) ) );
+   auto campaign = get_campaign( campaign_id );
+   BOOST_REQUIRE_EQUAL( asset::from_string("10.00000000 AMAX"), campaign["release"]["quantity"].as<asset>() );
+   BOOST_REQUIRE_EQUAL( 0, campaign["release"]["skipped"].as<asset>().get_amount() );
+   auto resumed_at = campaign["release"]["start_at"].as<time_point_sec>().sec_since_epoch();
+   BOOST_REQUIRE( resumed_at >= now() && resumed_at <= now() + 1 );
+   BOOST_REQUIRE_EQUAL( resumed_at + DAY_SECONDS, campaign["release"]["end_at"].as<time_point_sec>().sec_since_epoch() );
+
+   produce_days( 2 );
+   BOOST_REQUIRE_EQUAL( success(), collectint( N(alice), 1 ) );
+   BOOST_REQUIRE_EQUAL( asset::from_string("10.00000000 AMAX"), get_amax_balance( N(alice) ) );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( refuelsched_carries_skipped_into_next_schedule, amaxnft_mine_tester ) try {
+   auto campaign_id = create_campaign( 1, 100 );
+   produce_blocks();
+
+   uint32_t start_at = now() + 10;
+   BOOST_REQUIRE_EQUAL( success(), refuelsched( campaign_id, asset::from_string("10.00000000 AMAX"), start_at, start_at + DAY_SECONDS ) );
+   produce_days( 2 );
+
+   //still nothing pledged, the next schedule releases the skipped part again
+   start_at = now() + 10;
+   BOOST_REQUIRE_EQUAL( success(), refuelsched( campaign_id, asset::from_string("1.00000000 AMAX"), start_at, start_at + DAY_SECONDS ) );
+   auto campaign = get_campaign( campaign_id );
+   BOOST_REQUIRE_EQUAL( asset::from_string("11.00000000 AMAX"), campaign["release"]["quantity"].as<asset>() );
+   BOOST_REQUIRE_EQUAL( 0, campaign["release"]["skipped"].as<asset>().get_amount() );
+
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(alice), campaign_id, nasset( 1, 1 ) ) );
+   produce_days( 2 );
+   BOOST_REQUIRE_EQUAL( success(), collectint( N(alice), 1 ) );
+   BOOST_REQUIRE_EQUAL( asset::from_string("11.00000000 AMAX"), get_amax_balance( N(alice) ) );
+   BOOST_REQUIRE_EQUAL( asset::from_string("11.00000000 AMAX"), get_campaign( campaign_id )["interest_collected"].as<asset>() );
+} FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_SUITE_END()
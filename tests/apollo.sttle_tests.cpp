@@ -0,0 +1,324 @@
+#include "apollo_tester.hpp"
+
+static constexpr uint32_t START_TIME_SINCE_EPOCH = 1655569098;
+
+class apollo_sttle_tester : public apollo_tester {
+public:
+   const name APOLLO_TOKEN = N(apollo.token);
+   const name APOLLO_STTLE = N(apollo.sttle);
+   const name APOLLO_EV    = N(apollo.ev);
+   const name AM_TOKEN     = N(aplink);
+
+   apollo_sttle_tester() {
+      produce_blocks( 2 );
+
+      create_accounts( { APOLLO_TOKEN, APOLLO_STTLE, APOLLO_EV, AM_TOKEN, N(alice), N(bob) } );
+      produce_blocks( 2 );
+
+      deploy_contract( APOLLO_TOKEN, contracts::apollo_token_wasm(), contracts::apollo_token_abi() );
+      deploy_contract( APOLLO_STTLE, contracts::apollo_sttle_wasm(), contracts::apollo_sttle_abi() );
+      deploy_contract( APOLLO_EV,    contracts::apollo_ev_wasm(),    contracts::apollo_ev_abi() );
+      deploy_contract( AM_TOKEN,     contracts::deps::token_wasm(),  contracts::deps::token_abi() );
+      produce_blocks();
+
+      //settlement pays APLINK and burns the owners' electricity vouchers
+      create_currency( AM_TOKEN, AM_TOKEN, asset::from_string("10000000000.00 APLINK") );
+      issue( AM_TOKEN, AM_TOKEN, APOLLO_STTLE, asset::from_string("1000000.00 APLINK") );
+      BOOST_REQUIRE_EQUAL( success(), push_action( APOLLO_EV, APOLLO_EV, N(create), mvo()
+         ("burner", APOLLO_STTLE)
+         ("collector", APOLLO_EV)
+         ("maximum_supply", asset::from_string("10000000000.00 CNYD"))
+      ));
+      for (const auto& owner : { N(alice), N(bob) }) {
+         BOOST_REQUIRE_EQUAL( success(), push_action( APOLLO_EV, APOLLO_EV, N(issue), mvo()
+            ("to", owner)("quantity", asset::from_string("1000.00 CNYD"))("memo", "") ) );
+      }
+
+      //mining starts after start_time_since_epoch, sub token ids count days from it
+      produce_block( fc::seconds( START_TIME_SINCE_EPOCH + DAY_SECONDS - now() ) );
+      produce_blocks();
+
+      //tokens 1 and 2, three days of service life each
+      create_token( 3 );
+      produce_blocks();
+      create_token( 3 );
+      produce_blocks();
+   }
+
+   void create_token( const uint16_t& service_life_days ) {
+      BOOST_REQUIRE_EQUAL( success(), push_action( APOLLO_TOKEN, APOLLO_TOKEN, N(create), mvo()
+         ("issuer", APOLLO_TOKEN)
+         ("token_type", 1)
+         ("uri", "https://token")
+         ("invars", vector<fc::variant>{ fc::variant("pow_asset_invariables"), fc::variant( mvo()
+            ("manufacturer", "bitmain")
+            ("mine_coin_type", "btc")
+            ("hash_rate", mvo()("value", 1)("unit", "T"))
+            ("power_in_watt", 2100)
+            ("service_life_days", service_life_days)
+         ) })
+         ("vars", vector<fc::variant>{ fc::variant("power_asset_variables"), fc::variant( mvo()
+            ("mining_pool", "pool")
+            ("mining_location", "canada")
+            ("daily_earning_est", asset::from_string("1.00000000 AMETH"))
+            ("daily_electricity_charge", asset::from_string("0.85 CNYD"))
+            ("daily_svcfee_rate", 500)
+            ("actual_hash_rate", mvo()("value", 1)("unit", "T"))
+            ("onshelf_days", 1)
+         ) })
+         ("maximum_supply", 1000000)
+      ));
+   }
+
+   //credits today's bucket of token_id and starts mining it
+   void start_mining( const uint32_t& token_id, const name& owner, const int64_t& amount ) {
+      BOOST_REQUIRE_EQUAL( success(), push_action( APOLLO_TOKEN, APOLLO_TOKEN, N(issuebatch), mvo()
+         ("token_id", token_id)
+         ("recipients", vector<fc::variant>{ mvo()("first", owner)("second", amount) })
+         ("memo", "")
+      ));
+      BOOST_REQUIRE_EQUAL( success(), push_action( APOLLO_STTLE, owner, N(startmine), mvo()
+         ("token_id", token_id)("owner", owner)("beneficiary", owner) ) );
+   }
+
+   action_result settleall( const name& owner, const uint32_t& max_rows ) {
+      return push_action( APOLLO_STTLE, owner, N(settleall), mvo()("owner", owner)("max_rows", max_rows) );
+   }
+
+   action_result settledays( const name& signer, const uint64_t& id, const uint16_t& max_days ) {
+      return push_action( APOLLO_STTLE, signer, N(settledays), mvo()("id", id)("max_days", max_days) );
+   }
+
+   action_result crank( const uint32_t& day, const uint128_t& cursor, const uint32_t& max_rows ) {
+      return push_action( APOLLO_STTLE, APOLLO_STTLE, N(crank), mvo()("day", day)("cursor", cursor)("max_rows", max_rows) );
+   }
+
+   //the error code prefix is left out, only the message is matched
+   static bool failed_with( const action_result& result, const string& msg ) {
+      return result.size() >= msg.size() && result.compare( result.size() - msg.size(), msg.size(), msg ) == 0 &&
+             result.find( "assertion failure" ) != string::npos;
+   }
+
+   fc::variant get_sttle( const uint64_t& id ) {
+      return get_row( APOLLO_STTLE, APOLLO_STTLE.to_uint64_t(), N(sttles), id );
+   }
+
+   fc::variant get_due( const uint64_t& id ) {
+      return get_row( APOLLO_STTLE, APOLLO_STTLE.to_uint64_t(), N(sttledue), id );
+   }
+
+   uint32_t get_due_day( const uint64_t& id ) {
+      return get_due( id )["last_settled_day"].as<uint32_t>();
+   }
+
+   fc::variant get_crank() {
+      return get_row( APOLLO_STTLE, APOLLO_STTLE.to_uint64_t(), N(crank), N(crank).to_uint64_t() );
+   }
+
+   asset get_aplink( const name& owner ) {
+      return get_balance( AM_TOKEN, owner, symbol(2, "APLINK") );
+   }
+
+   asset get_cnyd( const name& owner ) {
+      auto row = get_row( APOLLO_EV, owner.to_uint64_t(), N(accounts), symbol(2, "CNYD").to_symbol_code().value );
+      return row.is_null() ? asset(0, symbol(2, "CNYD")) : row["balance"].as<asset>();
+   }
+};
+
+BOOST_AUTO_TEST_SUITE(apollo_sttle_tests)
+
+BOOST_FIXTURE_TEST_CASE( settleall_settles_due_records_of_owner, apollo_sttle_tester ) try {
+   start_mining( 1, N(alice), 10 );
+   start_mining( 2, N(alice), 10 );
+   start_mining( 1, N(bob), 10 );
+   auto start_day = get_due_day( 1 );
+   BOOST_REQUIRE_EQUAL( name("start"), get_due( 3 )["status"].as<name>() );
+
+   //nothing is due on the day mining starts
+   BOOST_REQUIRE( failed_with( settleall( N(alice), 10 ), "no record to settle: alice" ) );
+   produce_days( 1 );
+
+   BOOST_REQUIRE( failed_with( settleall( N(alice), 0 ), "max_rows must be positive" ) );
+   BOOST_REQUIRE( failed_with( push_action( APOLLO_STTLE, N(bob), N(settleall), mvo()("owner", N(alice))("max_rows", 10) ),
+                               "no permistion for settleall" ) );
+
+   //max_rows counts settled records
+   BOOST_REQUIRE_EQUAL( success(), settleall( N(alice), 1 ) );
+   auto earning = get_aplink( N(alice) );
+   BOOST_REQUIRE( earning.get_amount() > 0 );
+   BOOST_REQUIRE_EQUAL( asset::from_string("999.15 CNYD"), get_cnyd( N(alice) ) );
+   BOOST_REQUIRE_EQUAL( start_day + 1, get_due_day( 1 ) );
+   BOOST_REQUIRE_EQUAL( start_day, get_due_day( 2 ) );
+   BOOST_REQUIRE_EQUAL( 1u, get_sttle( 1 )["sttle_times"].as<uint16_t>() );
+
+   //the settled record is skipped, the other one pays the same
+   BOOST_REQUIRE_EQUAL( success(), settleall( N(alice), 10 ) );
+   BOOST_REQUIRE_EQUAL( earning + earning, get_aplink( N(alice) ) );
+   BOOST_REQUIRE_EQUAL( asset::from_string("998.30 CNYD"), get_cnyd( N(alice) ) );
+   BOOST_REQUIRE_EQUAL( start_day + 1, get_due_day( 2 ) );
+   produce_blocks();
+   BOOST_REQUIRE( failed_with( settleall( N(alice), 10 ), "no record to settle: alice" ) );
+
+   //other owners are untouched
+   BOOST_REQUIRE_EQUAL( start_day, get_due_day( 3 ) );
+   BOOST_REQUIRE_EQUAL( asset::from_string("1000.00 CNYD"), get_cnyd( N(bob) ) );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( settleall_skips_records_without_balance, apollo_sttle_tester ) try {
+   start_mining( 1, N(bob), 10 );
+   auto sub_token_id = get_sttle( 1 )["sub_token_id"].as<uint32_t>();
+   produce_days( 1 );
+
+   //the balance was sold, the record earns nothing
+   BOOST_REQUIRE_EQUAL( success(), push_action( APOLLO_TOKEN, N(bob), N(transfer), mvo()
+      ("from", N(bob))("to", N(alice))
+      ("quantity", mvo()("amount", 10)("symbol", mvo()("token_id", 1)("sub_token_id", sub_token_id)))
+      ("memo", "") ) );
+   BOOST_REQUIRE( failed_with( settleall( N(bob), 10 ), "no record to settle: bob" ) );
+   BOOST_REQUIRE_EQUAL( 0u, get_sttle( 1 )["sttle_times"].as<uint16_t>() );
+   BOOST_REQUIRE_EQUAL( asset::from_string("1000.00 CNYD"), get_cnyd( N(bob) ) );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( settledays_catches_up_in_one_transfer, apollo_sttle_tester ) try {
+   start_mining( 1, N(alice), 10 );
+   start_mining( 1, N(bob), 10 );
+   auto start_day = get_due_day( 1 );
+   BOOST_REQUIRE_EQUAL( start_day, get_due_day( 2 ) );
+
+   BOOST_REQUIRE( failed_with( settledays( N(alice), 1, 0 ), "max_days must be positive" ) );
+   BOOST_REQUIRE( failed_with( settledays( N(alice), 9, 1 ), "record not found: 9" ) );
+   BOOST_REQUIRE( failed_with( settledays( N(alice), 1, 1 ), "record is settled: 1" ) );
+   produce_days( 2 );
+
+   BOOST_REQUIRE( failed_with( settledays( N(bob), 1, 1 ), "no permistion for settledays" ) );
+
+   //one day for bob sets the daily rate
+   BOOST_REQUIRE_EQUAL( success(), settledays( N(bob), 2, 1 ) );
+   auto daily = get_aplink( N(bob) );
+   BOOST_REQUIRE( daily.get_amount() > 0 );
+   BOOST_REQUIRE_EQUAL( start_day + 1, get_due_day( 2 ) );
+   BOOST_REQUIRE_EQUAL( asset::from_string("999.15 CNYD"), get_cnyd( N(bob) ) );
+
+   //alice catches up every missed day at once, bounded by today
+   auto days = today() - start_day;
+   BOOST_REQUIRE_EQUAL( success(), settledays( N(alice), 1, 10 ) );
+   BOOST_REQUIRE_EQUAL( today(), get_due_day( 1 ) );
+   BOOST_REQUIRE_EQUAL( days, get_sttle( 1 )["sttle_times"].as<uint16_t>() );
+   BOOST_REQUIRE_EQUAL( asset( daily.get_amount() * days, daily.get_symbol() ), get_aplink( N(alice) ) );
+   BOOST_REQUIRE_EQUAL( asset( 100000 - 85 * days, symbol(2, "CNYD") ), get_cnyd( N(alice) ) );
+   BOOST_REQUIRE_EQUAL( today() * DAY_SECONDS, get_sttle( 1 )["last_settled_at"].as<fc::time_point>().sec_since_epoch() );
+   produce_blocks();
+   BOOST_REQUIRE( failed_with( settledays( N(alice), 1, 10 ), "record is settled: 1" ) );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( settledays_stops_at_service_life, apollo_sttle_tester ) try {
+   start_mining( 1, N(alice), 10 );
+   auto start_day = get_due_day( 1 );
+   produce_days( 5 );
+
+   //three days of service life, whatever max_days asks for
+   BOOST_REQUIRE_EQUAL( success(), settledays( N(alice), 1, 10 ) );
+   BOOST_REQUIRE_EQUAL( 3u, get_sttle( 1 )["sttle_times"].as<uint16_t>() );
+   BOOST_REQUIRE_EQUAL( start_day + 3, get_due_day( 1 ) );
+   BOOST_REQUIRE_EQUAL( asset::from_string("997.45 CNYD"), get_cnyd( N(alice) ) );
+
+   BOOST_REQUIRE( failed_with( settledays( N(alice), 1, 10 ), "service life ended: 1" ) );
+   BOOST_REQUIRE( failed_with( settleall( N(alice), 10 ), "no record to settle: alice" ) );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( settlement_advances_one_day_from_the_start_day, apollo_sttle_tester ) try {
+   start_mining( 1, N(alice), 10 );
+   auto start_day = get_due_day( 1 );
+   produce_days( 3 );
+
+   //a fresh record counts from its start day, not from the epoch
+   BOOST_REQUIRE_EQUAL( success(), push_action( APOLLO_STTLE, APOLLO_STTLE, N(settlement), mvo()
+      ("owner", N(alice))("id", 1)("type", "admin") ) );
+   auto daily = get_aplink( N(alice) );
+   BOOST_REQUIRE( daily.get_amount() > 0 );
+   BOOST_REQUIRE_EQUAL( start_day + 1, get_due_day( 1 ) );
+   BOOST_REQUIRE_EQUAL( (start_day + 1) * DAY_SECONDS, get_sttle( 1 )["last_settled_at"].as<fc::time_point>().sec_since_epoch() );
+
+   //owner settlement advances one day too
+   BOOST_REQUIRE_EQUAL( success(), push_action( APOLLO_STTLE, N(alice), N(settlement), mvo()
+      ("owner", N(alice))("id", 1)("type", "owner") ) );
+   BOOST_REQUIRE_EQUAL( start_day + 2, get_due_day( 1 ) );
+
+   //settledays only pays the days left
+   produce_blocks();
+   BOOST_REQUIRE_EQUAL( success(), settledays( N(alice), 1, 10 ) );
+   BOOST_REQUIRE_EQUAL( today(), get_due_day( 1 ) );
+   BOOST_REQUIRE_EQUAL( today() - start_day, get_sttle( 1 )["sttle_times"].as<uint16_t>() );
+   BOOST_REQUIRE_EQUAL( asset( daily.get_amount() * (today() - start_day), daily.get_symbol() ), get_aplink( N(alice) ) );
+   BOOST_REQUIRE_EQUAL( asset( 100000 - 85 * (today() - start_day), symbol(2, "CNYD") ), get_cnyd( N(alice) ) );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( crank_settles_due_records_in_pages, apollo_sttle_tester ) try {
+   start_mining( 1, N(alice), 10 );
+   start_mining( 2, N(alice), 10 );
+   start_mining( 1, N(bob), 10 );
+   produce_days( 2 );
+
+   BOOST_REQUIRE_EQUAL( error("missing authority of apollo.sttle"), push_action( APOLLO_STTLE, N(alice), N(crank), mvo()
+      ("day", today())("cursor", 0)("max_rows", 10) ) );
+   BOOST_REQUIRE( failed_with( crank( today(), 0, 0 ), "max_rows must be positive" ) );
+   BOOST_REQUIRE( failed_with( crank( today() + 1, 0, 10 ), "day not reached: " + std::to_string( today() + 1 ) ) );
+
+   //one row per page, the singleton keeps the resume cursor
+   BOOST_REQUIRE_EQUAL( success(), crank( today(), 0, 1 ) );
+   auto page = get_crank();
+   BOOST_REQUIRE_EQUAL( today(), page["day"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( 1u, page["settled_count"].as<uint32_t>() );
+   BOOST_REQUIRE( page["next_key"].as<uint128_t>() != 0 );
+   BOOST_REQUIRE_EQUAL( today(), get_due_day( 1 ) );
+   BOOST_REQUIRE_EQUAL( 2u, get_sttle( 1 )["sttle_times"].as<uint16_t>() );
+
+   BOOST_REQUIRE_EQUAL( success(), crank( today(), page["next_key"].as<uint128_t>(), 10 ) );
+   page = get_crank();
+   BOOST_REQUIRE_EQUAL( 2u, page["settled_count"].as<uint32_t>() );
+   BOOST_REQUIRE( page["next_key"].as<uint128_t>() == 0 );
+   BOOST_REQUIRE_EQUAL( today(), get_due_day( 2 ) );
+   BOOST_REQUIRE_EQUAL( today(), get_due_day( 3 ) );
+
+   //two records for alice, one for bob, both days settled at once
+   auto earning = get_aplink( N(bob) );
+   BOOST_REQUIRE( earning.get_amount() > 0 );
+   BOOST_REQUIRE_EQUAL( earning + earning, get_aplink( N(alice) ) );
+   BOOST_REQUIRE_EQUAL( asset::from_string("996.60 CNYD"), get_cnyd( N(alice) ) );
+   BOOST_REQUIRE_EQUAL( asset::from_string("998.30 CNYD"), get_cnyd( N(bob) ) );
+
+   //nothing is due any more
+   produce_blocks();
+   BOOST_REQUIRE_EQUAL( success(), crank( today(), 0, 10 ) );
+   BOOST_REQUIRE_EQUAL( 0u, get_crank()["settled_count"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( earning + earning, get_aplink( N(alice) ) );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( crank_drops_ended_records_from_due_index, apollo_sttle_tester ) try {
+   start_mining( 1, N(alice), 10 );
+   auto start_day = get_due_day( 1 );
+   produce_days( 5 );
+
+   //service life bounds the days settled
+   BOOST_REQUIRE_EQUAL( success(), crank( today(), 0, 10 ) );
+   BOOST_REQUIRE_EQUAL( 3u, get_sttle( 1 )["sttle_times"].as<uint16_t>() );
+   BOOST_REQUIRE_EQUAL( start_day + 3, get_due_day( 1 ) );
+   BOOST_REQUIRE_EQUAL( asset::from_string("997.45 CNYD"), get_cnyd( N(alice) ) );
+
+   //the ended record leaves the due index, the record itself stays
+   produce_blocks();
+   BOOST_REQUIRE_EQUAL( success(), crank( today(), 0, 10 ) );
+   BOOST_REQUIRE_EQUAL( 0u, get_crank()["settled_count"].as<uint32_t>() );
+   BOOST_REQUIRE( get_due( 1 ).is_null() );
+   BOOST_REQUIRE( !get_sttle( 1 ).is_null() );
+
+   //indexdue rebuilds due rows from the records
+   BOOST_REQUIRE_EQUAL( error("missing authority of apollo.sttle"), push_action( APOLLO_STTLE, N(alice), N(indexdue), mvo()
+      ("cursor", 0)("max_rows", 10) ) );
+   BOOST_REQUIRE( failed_with( push_action( APOLLO_STTLE, APOLLO_STTLE, N(indexdue), mvo()("cursor", 0)("max_rows", 0) ),
+                               "max_rows must be positive" ) );
+   BOOST_REQUIRE_EQUAL( success(), push_action( APOLLO_STTLE, APOLLO_STTLE, N(indexdue), mvo()("cursor", 0)("max_rows", 10) ) );
+   BOOST_REQUIRE_EQUAL( start_day + 3, get_due_day( 1 ) );
+} FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,444 @@
+#include "apollo_tester.hpp"
+
+#include <fc/crypto/sha256.hpp>
+
+static constexpr uint32_t START_TIME_SINCE_EPOCH = 1655569098;
+
+class apollo_token_tester : public apollo_tester {
+public:
+   const name APOLLO_TOKEN = N(apollo.token);
+   const name APOLLO_STTLE = N(apollo.sttle);
+
+   apollo_token_tester() {
+      produce_blocks( 2 );
+
+      create_accounts( { APOLLO_TOKEN, APOLLO_STTLE, N(alice), N(bob) } );
+      produce_blocks( 2 );
+
+      deploy_contract( APOLLO_TOKEN, contracts::apollo_token_wasm(), contracts::apollo_token_abi() );
+
+      //transfers are only open after start_time_since_epoch
+      produce_block( fc::seconds( START_TIME_SINCE_EPOCH + DAY_SECONDS - now() ) );
+      produce_blocks();
+   }
+
+   static fc::variant invars() {
+      return vector<fc::variant>{ fc::variant("pow_asset_invariables"), fc::variant( mvo()
+         ("manufacturer", "bitmain")
+         ("mine_coin_type", "btc")
+         ("hash_rate", mvo()("value", 21.5)("unit", "T"))
+         ("power_in_watt", 2100)
+         ("service_life_days", 1095)
+      ) };
+   }
+
+   static fc::variant vars() {
+      return vector<fc::variant>{ fc::variant("power_asset_variables"), fc::variant( mvo()
+         ("mining_pool", "pool")
+         ("mining_location", "canada")
+         ("daily_earning_est", asset::from_string("0.00397002 AMETH"))
+         ("daily_electricity_charge", asset::from_string("0.85 CNYD"))
+         ("daily_svcfee_rate", 500)
+         ("actual_hash_rate", mvo()("value", 21.5)("unit", "T"))
+         ("onshelf_days", 1)
+      ) };
+   }
+
+   //the pow invariant hash computed by the contract
+   static string invars_hash( const uint8_t& token_type ) {
+      string str = to_string( token_type ) + "\n" + "bitmain" + "\n" + "btc" + "\n" + "21.500000 T" + "\n" +
+                   "2100.000000" + "\n" + "1095";
+      return fc::sha256::hash( str ).str();
+   }
+
+   action_result create( const int64_t& maximum_supply, const uint8_t& token_type = 1 ) {
+      return push_action( APOLLO_TOKEN, APOLLO_TOKEN, N(create), mvo()
+         ("issuer", APOLLO_TOKEN)
+         ("token_type", token_type)
+         ("uri", "https://token")
+         ("invars", invars())
+         ("vars", vars())
+         ("maximum_supply", maximum_supply)
+      );
+   }
+
+   static fc::variant token_asset( const int64_t& amount, const uint32_t& token_id, const uint32_t& sub_token_id = 0 ) {
+      return mvo()("amount", amount)("symbol", mvo()("token_id", token_id)("sub_token_id", sub_token_id));
+   }
+
+   action_result issue_token( const fc::variant& quantity ) {
+      return push_action( APOLLO_TOKEN, APOLLO_TOKEN, N(issue), mvo()("to", APOLLO_TOKEN)("quantity", quantity)("memo", "") );
+   }
+
+   action_result transfer_token( const name& from, const name& to, const fc::variant& quantity ) {
+      return push_action( APOLLO_TOKEN, from, N(transfer), mvo()("from", from)("to", to)("quantity", quantity)("memo", "") );
+   }
+
+   action_result transferx( const name& from, const name& to, const vector<fc::variant>& quantities ) {
+      return push_action( APOLLO_TOKEN, from, N(transferx), mvo()("from", from)("to", to)("quantities", quantities)("memo", "") );
+   }
+
+   action_result merge( const name& owner, const uint32_t& token_id, const vector<uint32_t>& sub_ids, const uint32_t& target_sub_id ) {
+      return push_action( APOLLO_TOKEN, owner, N(merge), mvo()
+         ("owner", owner)("token_id", token_id)("sub_ids", sub_ids)("target_sub_id", target_sub_id) );
+   }
+
+   action_result issuebatch( const uint32_t& token_id, const vector<std::pair<name, int64_t>>& recipients ) {
+      vector<fc::variant> pairs;
+      for (const auto& [to, amount] : recipients)
+         pairs.push_back( mvo()("first", to)("second", amount) );
+      return push_action( APOLLO_TOKEN, APOLLO_TOKEN, N(issuebatch), mvo()
+         ("token_id", token_id)("recipients", pairs)("memo", "airdrop") );
+   }
+
+   //sub token id stamped on balances received now
+   uint32_t today_sub_token_id() {
+      return ( now() - START_TIME_SINCE_EPOCH ) / DAY_SECONDS;
+   }
+
+   action_result pausetoken( const uint64_t& token_id, const bool& paused ) {
+      return push_action( APOLLO_TOKEN, APOLLO_TOKEN, N(pausetoken), mvo()("token_id", token_id)("paused", paused) );
+   }
+
+   //paused bit of token_id in the pausemap
+   bool get_pause_bit( const uint64_t& token_id ) {
+      auto words = get_singleton( APOLLO_TOKEN, N(pausemap) )["words"].as<vector<uint64_t>>();
+      return token_id / 64 < words.size() && (words[token_id / 64] >> (token_id % 64) & 1);
+   }
+
+   action_result syncpause( const uint32_t& max_rows ) {
+      return push_action( APOLLO_TOKEN, APOLLO_TOKEN, N(syncpause), mvo()("max_rows", max_rows) );
+   }
+
+   //issues to the creator, then hands the balance to owner
+   void give( const name& owner, const int64_t& amount, const uint32_t& token_id, const uint32_t& sub_token_id = 0 ) {
+      BOOST_REQUIRE_EQUAL( success(), issue_token( token_asset( amount, token_id, sub_token_id ) ) );
+      BOOST_REQUIRE_EQUAL( success(), transfer_token( APOLLO_TOKEN, owner, token_asset( amount, token_id, sub_token_id ) ) );
+   }
+
+   int64_t get_token_balance( const name& owner, const uint32_t& token_id, const uint32_t& sub_token_id = 0 ) {
+      auto row = get_row( APOLLO_TOKEN, owner.to_uint64_t(), N(accounts), (uint64_t)token_id << 32 | sub_token_id );
+      return row.is_null() ? 0 : row["balance"]["amount"].as<int64_t>();
+   }
+
+   fc::variant get_tokenstats( const uint32_t& token_id ) {
+      return get_row( APOLLO_TOKEN, APOLLO_TOKEN.to_uint64_t(), N(tokenstats), token_id );
+   }
+
+   fc::variant get_tokensupply( const uint32_t& token_id ) {
+      return get_row( APOLLO_TOKEN, APOLLO_TOKEN.to_uint64_t(), N(tokensupply), token_id );
+   }
+};
+
+BOOST_AUTO_TEST_SUITE(apollo_token_tests)
+
+BOOST_FIXTURE_TEST_CASE( create_stores_invars_hash, apollo_token_tester ) try {
+   BOOST_REQUIRE_EQUAL( error("missing authority of apollo.token"), push_action( APOLLO_TOKEN, N(alice), N(create), mvo()
+      ("issuer", APOLLO_TOKEN)("token_type", 1)("uri", "https://token")("invars", invars())("vars", vars())("maximum_supply", 100) ) );
+
+   BOOST_REQUIRE_EQUAL( success(), create( 100 ) );
+   auto stats = get_tokenstats( 1 );
+   BOOST_REQUIRE_EQUAL( invars_hash( 1 ), stats["invars_hash"].as<string>() );
+
+   //only pow tokens hash their invariables
+   BOOST_REQUIRE_EQUAL( success(), create( 100, 2 ) );
+   BOOST_REQUIRE_EQUAL( fc::sha256().str(), get_tokenstats( 2 )["invars_hash"].as<string>() );
+
+   //every stored row already has its hash, the backfill leaves it as is
+   BOOST_REQUIRE_EQUAL( error("missing authority of apollo.token"),
+      push_action( APOLLO_TOKEN, N(alice), N(fillinvhash), mvo()("cursor", 0)("max_rows", 10) ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("$$$8$$$ max_rows must be positive"),
+      push_action( APOLLO_TOKEN, APOLLO_TOKEN, N(fillinvhash), mvo()("cursor", 0)("max_rows", 0) ) );
+   BOOST_REQUIRE_EQUAL( success(), push_action( APOLLO_TOKEN, APOLLO_TOKEN, N(fillinvhash), mvo()("cursor", 0)("max_rows", 10) ) );
+   BOOST_REQUIRE_EQUAL( invars_hash( 1 ), get_tokenstats( 1 )["invars_hash"].as<string>() );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( transferx_moves_several_assets, apollo_token_tester ) try {
+   BOOST_REQUIRE_EQUAL( success(), create( 100 ) );
+   produce_blocks();
+   BOOST_REQUIRE_EQUAL( success(), create( 100 ) );
+   give( N(alice), 10, 1 );
+   give( N(alice), 10, 1, 3 );
+   give( N(alice), 10, 2 );
+   produce_blocks();
+
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("$$$5$$$ quantities is empty"), transferx( N(alice), N(bob), {} ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("$$$7$$$ cannot transfer to self"), transferx( N(alice), N(alice), { token_asset( 1, 1 ) } ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("$$$8$$$ must transfer positive quantity"),
+                        transferx( N(alice), N(bob), { token_asset( 1, 1 ), token_asset( 0, 2 ) } ) );
+   BOOST_REQUIRE_EQUAL( error("missing authority of alice"), push_action( APOLLO_TOKEN, N(bob), N(transferx), mvo()
+      ("from", N(alice))("to", N(bob))("quantities", vector<fc::variant>{ token_asset( 1, 1 ) })("memo", "") ) );
+
+   //quantities of one symbol are merged before the balance check
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("$$$10$$$ overdrawn balance"),
+                        transferx( N(alice), N(bob), { token_asset( 6, 1 ), token_asset( 1, 2 ), token_asset( 5, 1 ) } ) );
+   BOOST_REQUIRE_EQUAL( 10, get_token_balance( N(alice), 2 ) );
+
+   BOOST_REQUIRE_EQUAL( success(),
+      transferx( N(alice), N(bob), { token_asset( 3, 1 ), token_asset( 1, 2 ), token_asset( 2, 1 ), token_asset( 4, 1, 3 ) } ) );
+   BOOST_REQUIRE_EQUAL( 5, get_token_balance( N(alice), 1 ) );
+   BOOST_REQUIRE_EQUAL( 6, get_token_balance( N(alice), 1, 3 ) );
+   BOOST_REQUIRE_EQUAL( 9, get_token_balance( N(alice), 2 ) );
+   BOOST_REQUIRE_EQUAL( 5, get_token_balance( N(bob), 1 ) );
+   BOOST_REQUIRE_EQUAL( 4, get_token_balance( N(bob), 1, 3 ) );
+   BOOST_REQUIRE_EQUAL( 1, get_token_balance( N(bob), 2 ) );
+   BOOST_REQUIRE_EQUAL( 3u, get_rows( APOLLO_TOKEN, N(bob).to_uint64_t(), N(accounts) ).size() );
+
+   //a missing balance fails the whole transfer
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("$$$1$$$ account balance not found"),
+                        transferx( N(bob), N(alice), { token_asset( 1, 1 ), token_asset( 1, 1, 9 ) } ) );
+   BOOST_REQUIRE_EQUAL( 5, get_token_balance( N(bob), 1 ) );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( merge_folds_day_buckets, apollo_token_tester ) try {
+   BOOST_REQUIRE_EQUAL( success(), create( 100 ) );
+   give( N(alice), 5, 1, 3 );
+   give( N(alice), 2, 1, 5 );
+   give( N(alice), 1, 1, 7 );
+   produce_blocks();
+
+   BOOST_REQUIRE_EQUAL( error("missing authority of alice"), push_action( APOLLO_TOKEN, N(bob), N(merge), mvo()
+      ("owner", N(alice))("token_id", 1)("sub_ids", vector<uint32_t>{ 3, 5 })("target_sub_id", 3) ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("$$$5$$$ sub_ids must have more than one sub id"), merge( N(alice), 1, { 3 }, 3 ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("$$$5$$$ target sub id must be the oldest of sub_ids: 5"), merge( N(alice), 1, { 3, 5 }, 5 ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("$$$5$$$ duplicate sub id: 5"), merge( N(alice), 1, { 3, 5, 5 }, 3 ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("$$$1$$$ account balance not found: 1"), merge( N(alice), 1, { 1, 5 }, 1 ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("$$$1$$$ account balance not found: 9"), merge( N(alice), 1, { 3, 9 }, 3 ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("$$$1$$$ token asset not found: 2"), merge( N(alice), 2, { 3, 5 }, 3 ) );
+
+   BOOST_REQUIRE_EQUAL( success(), merge( N(alice), 1, { 7, 3, 5 }, 3 ) );
+   BOOST_REQUIRE_EQUAL( 8, get_token_balance( N(alice), 1, 3 ) );
+   BOOST_REQUIRE( get_row( APOLLO_TOKEN, N(alice).to_uint64_t(), N(accounts), (uint64_t)1 << 32 | 5 ).is_null() );
+   BOOST_REQUIRE( get_row( APOLLO_TOKEN, N(alice).to_uint64_t(), N(accounts), (uint64_t)1 << 32 | 7 ).is_null() );
+   BOOST_REQUIRE_EQUAL( 8, get_tokensupply( 1 )["supply"].as<int64_t>() );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( balancesof_reports_sum_without_writing, apollo_token_tester ) try {
+   BOOST_REQUIRE_EQUAL( success(), create( 100 ) );
+   BOOST_REQUIRE_EQUAL( success(), issuebatch( 1, { { N(alice), 3 } } ) );
+   produce_days( 1 );
+   BOOST_REQUIRE_EQUAL( success(), issuebatch( 1, { { N(alice), 4 } } ) );
+   produce_blocks();
+
+   BOOST_REQUIRE_EQUAL( error("missing authority of apollo.token"), push_action( APOLLO_TOKEN, N(alice), N(balancelog), mvo()
+      ("owner", N(alice))("token_id", 1)("total", 100)("balances", vector<fc::variant>{}) ) );
+
+   //anyone may query, the result rides on the inline balancelog action
+   auto trace = base_tester::push_action( APOLLO_TOKEN, N(balancesof), N(bob), mvo()("owner", N(alice))("token_id", 1) );
+   fc::variant log;
+   for (const auto& act_trace : trace->action_traces) {
+      if (act_trace.act.name != N(balancelog)) continue;
+      log = abis.at( APOLLO_TOKEN ).binary_to_variant( "balancelog", act_trace.act.data, abi_serializer_max_time );
+   }
+   BOOST_REQUIRE( !log.is_null() );
+   BOOST_REQUIRE_EQUAL( 7, log["total"].as<int64_t>() );
+   auto balances = log["balances"].get_array();
+   BOOST_REQUIRE_EQUAL( 2u, balances.size() );
+   BOOST_REQUIRE_EQUAL( 3, balances[0]["amount"].as<int64_t>() );
+   BOOST_REQUIRE_EQUAL( 4, balances[1]["amount"].as<int64_t>() );
+   BOOST_REQUIRE_EQUAL( 2u, get_rows( APOLLO_TOKEN, N(alice).to_uint64_t(), N(accounts) ).size() );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( merge_rejects_paused_balances, apollo_token_tester ) try {
+   BOOST_REQUIRE_EQUAL( success(), create( 100 ) );
+   give( N(alice), 5, 1, 3 );
+   give( N(alice), 2, 1, 5 );
+   produce_blocks();
+
+   BOOST_REQUIRE_EQUAL( success(), push_action( APOLLO_TOKEN, APOLLO_TOKEN, N(pauseaccount), mvo()
+      ("owner", N(alice))("symbol", mvo()("token_id", 1)("sub_token_id", 5))("paused", true) ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("$$$6$$$ account balance being paused: 5"), merge( N(alice), 1, { 3, 5 }, 3 ) );
+   BOOST_REQUIRE_EQUAL( success(), push_action( APOLLO_TOKEN, APOLLO_TOKEN, N(pauseaccount), mvo()
+      ("owner", N(alice))("symbol", mvo()("token_id", 1)("sub_token_id", 5))("paused", false) ) );
+
+   BOOST_REQUIRE_EQUAL( success(), push_action( APOLLO_TOKEN, APOLLO_TOKEN, N(pausetoken), mvo()("token_id", 1)("paused", true) ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("$$$6$$$ token being paused: 1"), merge( N(alice), 1, { 3, 5 }, 3 ) );
+   BOOST_REQUIRE_EQUAL( 5, get_token_balance( N(alice), 1, 3 ) );
+   BOOST_REQUIRE_EQUAL( 2, get_token_balance( N(alice), 1, 5 ) );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( issuebatch_credits_recipients, apollo_token_tester ) try {
+   BOOST_REQUIRE_EQUAL( success(), create( 10 ) );
+   produce_blocks();
+
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("$$$5$$$ recipients is empty"), issuebatch( 1, {} ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("$$$1$$$ token not found: 2"), issuebatch( 2, { { N(alice), 1 } } ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("$$$1$$$ to account does not exist: nobody"), issuebatch( 1, { { N(alice), 1 }, { N(nobody), 1 } } ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("$$$8$$$ must issue positive quantity"), issuebatch( 1, { { N(alice), 0 } } ) );
+   //the supply check covers the whole batch
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("$$$10$$$ quantity exceeds available supply"), issuebatch( 1, { { N(alice), 6 }, { N(bob), 5 } } ) );
+   BOOST_REQUIRE_EQUAL( error("missing authority of apollo.token"), push_action( APOLLO_TOKEN, N(alice), N(issuebatch), mvo()
+      ("token_id", 1)("recipients", vector<fc::variant>{ mvo()("first", N(alice))("second", 1) })("memo", "") ) );
+
+   //recipients receive today's bucket directly, the creator holds nothing
+   BOOST_REQUIRE_EQUAL( success(), issuebatch( 1, { { N(alice), 3 }, { N(bob), 2 }, { N(alice), 1 } } ) );
+   auto sub_token_id = today_sub_token_id();
+   BOOST_REQUIRE_EQUAL( 4, get_token_balance( N(alice), 1, sub_token_id ) );
+   BOOST_REQUIRE_EQUAL( 2, get_token_balance( N(bob), 1, sub_token_id ) );
+   BOOST_REQUIRE( get_rows( APOLLO_TOKEN, APOLLO_TOKEN.to_uint64_t(), N(accounts) ).empty() );
+   BOOST_REQUIRE_EQUAL( 6, get_tokensupply( 1 )["supply"].as<int64_t>() );
+
+   //notifications can be skipped
+   BOOST_REQUIRE_EQUAL( success(), push_action( APOLLO_TOKEN, APOLLO_TOKEN, N(issuebatch), mvo()
+      ("token_id", 1)("recipients", vector<fc::variant>{ mvo()("first", N(bob))("second", 4) })("memo", "")("notify", false) ) );
+   BOOST_REQUIRE_EQUAL( 6, get_token_balance( N(bob), 1, sub_token_id ) );
+   BOOST_REQUIRE_EQUAL( 10, get_tokensupply( 1 )["supply"].as<int64_t>() );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("$$$10$$$ quantity exceeds available supply"), issuebatch( 1, { { N(alice), 1 } } ) );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( issuebatch_memo_reaches_recipients, apollo_token_tester ) try {
+   BOOST_REQUIRE_EQUAL( success(), create( 10 ) );
+   produce_blocks();
+
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("$$$10$$$ memo has more than 256 bytes"), push_action( APOLLO_TOKEN, APOLLO_TOKEN, N(issuebatch), mvo()
+      ("token_id", 1)("recipients", vector<fc::variant>{ mvo()("first", N(alice))("second", 1) })("memo", string(257, 'm')) ) );
+
+   //each recipient is notified with the issuebatch action, memo included
+   auto memos_to_alice = [&]( const bool notify ) {
+      auto trace = base_tester::push_action( APOLLO_TOKEN, N(issuebatch), APOLLO_TOKEN, mvo()
+         ("token_id", 1)("recipients", vector<fc::variant>{ mvo()("first", N(alice))("second", 1) })("memo", "airdrop")("notify", notify) );
+      vector<string> memos;
+      for (const auto& act_trace : trace->action_traces) {
+         if (act_trace.receiver != N(alice)) continue;
+         auto data = abis.at( APOLLO_TOKEN ).binary_to_variant( "issuebatch", act_trace.act.data, abi_serializer_max_time );
+         memos.push_back( data["memo"].as<string>() );
+      }
+      return memos;
+   };
+   BOOST_REQUIRE( memos_to_alice( true ) == vector<string>{ "airdrop" } );
+   BOOST_REQUIRE( memos_to_alice( false ).empty() );
+   BOOST_REQUIRE_EQUAL( 2, get_token_balance( N(alice), 1, today_sub_token_id() ) );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( issuebatch_stamps_the_current_day, apollo_token_tester ) try {
+   BOOST_REQUIRE_EQUAL( success(), create( 10 ) );
+   produce_blocks();
+
+   BOOST_REQUIRE_EQUAL( success(), issuebatch( 1, { { N(alice), 1 } } ) );
+   auto first_day = today_sub_token_id();
+   produce_days( 1 );
+   BOOST_REQUIRE_EQUAL( success(), issuebatch( 1, { { N(alice), 2 } } ) );
+
+   BOOST_REQUIRE_EQUAL( first_day + 1, today_sub_token_id() );
+   BOOST_REQUIRE_EQUAL( 1, get_token_balance( N(alice), 1, first_day ) );
+   BOOST_REQUIRE_EQUAL( 2, get_token_balance( N(alice), 1, first_day + 1 ) );
+   BOOST_REQUIRE_EQUAL( 3, get_tokensupply( 1 )["supply"].as<int64_t>() );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( supply_ledger_split_from_tokenstats, apollo_token_tester ) try {
+   BOOST_REQUIRE_EQUAL( success(), create( 10 ) );
+   auto supply = get_tokensupply( 1 );
+   BOOST_REQUIRE_EQUAL( 10, supply["max_supply"].as<int64_t>() );
+   BOOST_REQUIRE_EQUAL( 0, supply["supply"].as<int64_t>() );
+   BOOST_REQUIRE_EQUAL( APOLLO_TOKEN, supply["creator"].as<name>() );
+   BOOST_REQUIRE_EQUAL( false, supply["paused"].as<bool>() );
+   BOOST_REQUIRE_EQUAL( "https://token", get_tokenstats( 1 )["token_uri"].as<string>() );
+   produce_blocks();
+
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("$$$1$$$ token not found: 2"), issue_token( token_asset( 1, 2 ) ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("$$$10$$$ quantity exceeds available supply"), issue_token( token_asset( 11, 1 ) ) );
+
+   //issue and retire only move the supply ledger
+   BOOST_REQUIRE_EQUAL( success(), issue_token( token_asset( 7, 1 ) ) );
+   BOOST_REQUIRE_EQUAL( success(), push_action( APOLLO_TOKEN, APOLLO_TOKEN, N(retire), mvo()
+      ("quantity", token_asset( 2, 1 ))("memo", "") ) );
+   BOOST_REQUIRE_EQUAL( 5, get_tokensupply( 1 )["supply"].as<int64_t>() );
+   BOOST_REQUIRE_EQUAL( 0, get_tokenstats( 1 )["supply"].as<int64_t>() );
+   BOOST_REQUIRE_EQUAL( 5, get_token_balance( APOLLO_TOKEN, 1 ) );
+
+   BOOST_REQUIRE_EQUAL( success(), issuebatch( 1, { { N(alice), 5 } } ) );
+   BOOST_REQUIRE_EQUAL( 10, get_tokensupply( 1 )["supply"].as<int64_t>() );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("$$$10$$$ quantity exceeds available supply"), issue_token( token_asset( 1, 1 ) ) );
+
+   //pausing only flags the supply row
+   BOOST_REQUIRE_EQUAL( success(), push_action( APOLLO_TOKEN, APOLLO_TOKEN, N(pausetoken), mvo()("token_id", 1)("paused", true) ) );
+   BOOST_REQUIRE_EQUAL( true, get_tokensupply( 1 )["paused"].as<bool>() );
+   BOOST_REQUIRE_EQUAL( false, get_tokenstats( 1 )["paused"].as<bool>() );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( owner_balances_are_ranged_by_token_id, apollo_token_tester ) try {
+   BOOST_REQUIRE_EQUAL( success(), create( 100 ) );
+   produce_blocks();
+   BOOST_REQUIRE_EQUAL( success(), create( 100 ) );
+   produce_blocks();
+
+   //settlement sums an owner's balances of one token_id from token_id << 32 up to the next token_id
+   give( N(alice), 2, 2 );
+   give( N(alice), 1, 1, 0xFFFFFFFF );
+   give( N(alice), 3, 1, 5 );
+   give( N(alice), 4, 1 );
+   give( N(bob), 8, 1, 5 );
+
+   auto rows = get_rows( APOLLO_TOKEN, N(alice).to_uint64_t(), N(accounts) );
+   BOOST_REQUIRE_EQUAL( 4u, rows.size() );
+   vector<std::pair<uint32_t, uint32_t>> symbols;
+   int64_t token_1_total = 0;
+   for (const auto& row : rows) {
+      auto token_id = row["balance"]["symbol"]["token_id"].as<uint32_t>();
+      symbols.emplace_back( token_id, row["balance"]["symbol"]["sub_token_id"].as<uint32_t>() );
+      if (token_id == 1) token_1_total += row["balance"]["amount"].as<int64_t>();
+   }
+   BOOST_REQUIRE( ( vector<std::pair<uint32_t, uint32_t>>{ { 1, 0 }, { 1, 5 }, { 1, 0xFFFFFFFF }, { 2, 0 } } ) == symbols );
+   BOOST_REQUIRE_EQUAL( 8, token_1_total );
+
+   //plain transfers keep the day bucket
+   BOOST_REQUIRE_EQUAL( success(), transfer_token( N(alice), N(bob), token_asset( 1, 1, 5 ) ) );
+   BOOST_REQUIRE_EQUAL( 9, get_token_balance( N(bob), 1, 5 ) );
+   BOOST_REQUIRE_EQUAL( 2, get_token_balance( N(alice), 1, 5 ) );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( pause_bitmap_gates_transfers, apollo_token_tester ) try {
+   BOOST_REQUIRE_EQUAL( success(), create( 100 ) );
+   give( N(alice), 10, 1 );
+   produce_blocks();
+
+   //tokens created with the bitmap in place are mirrored by it from the start
+   BOOST_REQUIRE_EQUAL( 1, get_singleton( APOLLO_TOKEN, N(pausemap) )["created_from"].as<uint64_t>() );
+   BOOST_REQUIRE( !get_pause_bit( 1 ) );
+
+   BOOST_REQUIRE_EQUAL( error("missing authority of apollo.token"),
+      push_action( APOLLO_TOKEN, N(alice), N(pausetoken), mvo()("token_id", 1)("paused", true) ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("$$$1$$$ token not found: 9"), pausetoken( 9, true ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("$$$5$$$ already paused: 0"), pausetoken( 1, false ) );
+
+   BOOST_REQUIRE_EQUAL( success(), pausetoken( 1, true ) );
+   BOOST_REQUIRE( get_pause_bit( 1 ) );
+   BOOST_REQUIRE_EQUAL( true, get_tokensupply( 1 )["paused"].as<bool>() );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("$$$6$$$ token being paused: 1"), transfer_token( N(alice), N(bob), token_asset( 1, 1 ) ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("$$$6$$$ token being paused: 1"), transferx( N(alice), N(bob), { token_asset( 1, 1 ) } ) );
+   produce_blocks();
+
+   BOOST_REQUIRE_EQUAL( success(), pausetoken( 1, false ) );
+   BOOST_REQUIRE( !get_pause_bit( 1 ) );
+   BOOST_REQUIRE_EQUAL( success(), transfer_token( N(alice), N(bob), token_asset( 1, 1 ) ) );
+   BOOST_REQUIRE_EQUAL( 1, get_token_balance( N(bob), 1 ) );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( syncpause_mirrors_the_supply_row, apollo_token_tester ) try {
+   //tokens past the first bitmap word; creating them writes no bits
+   for (uint32_t i = 0; i < 65; i++) {
+      BOOST_REQUIRE_EQUAL( success(), create( 100 + i ) );
+   }
+   produce_blocks();
+   auto pauses = get_singleton( APOLLO_TOKEN, N(pausemap) );
+   BOOST_REQUIRE_EQUAL( 0u, pauses["words"].as<vector<uint64_t>>().size() );
+   BOOST_REQUIRE_EQUAL( 1, pauses["created_from"].as<uint64_t>() );
+
+   BOOST_REQUIRE_EQUAL( success(), pausetoken( 65, true ) );
+   BOOST_REQUIRE_EQUAL( 2u, get_singleton( APOLLO_TOKEN, N(pausemap) )["words"].as<vector<uint64_t>>().size() );
+   BOOST_REQUIRE( get_pause_bit( 65 ) );
+   BOOST_REQUIRE( !get_pause_bit( 1 ) );
+
+   BOOST_REQUIRE_EQUAL( error("missing authority of apollo.token"),
+      push_action( APOLLO_TOKEN, N(alice), N(syncpause), mvo()("max_rows", 10) ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("$$$8$$$ max_rows must be positive"), syncpause( 0 ) );
+
+   //nothing predates the bitmap, so there is nothing to backfill
+   BOOST_REQUIRE_EQUAL( success(), syncpause( 10 ) );
+   pauses = get_singleton( APOLLO_TOKEN, N(pausemap) );
+   BOOST_REQUIRE_EQUAL( 1, pauses["synced_upto"].as<uint64_t>() );
+   BOOST_REQUIRE( get_pause_bit( 65 ) );
+   BOOST_REQUIRE( !get_pause_bit( 1 ) );
+} FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_SUITE_END()
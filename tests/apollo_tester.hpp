@@ -0,0 +1,179 @@
+#pragma once
+
+#include <eosio/chain/abi_serializer.hpp>
+#include <eosio/testing/tester.hpp>
+
+#include <fc/variant_object.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+
+#include "contracts.hpp"
+
+using namespace eosio::chain;
+using namespace eosio::testing;
+using namespace fc;
+using namespace std;
+
+using mvo = fc::mutable_variant_object;
+
+#ifndef TESTER
+#ifdef NON_VALIDATING_TEST
+#define TESTER tester
+#else
+#define TESTER validating_tester
+#endif
+#endif
+
+static constexpr uint64_t DAY_SECONDS = 24 * 60 * 60;
+
+class apollo_tester : public TESTER {
+public:
+
+   void deploy_contract( const name& account, const vector<uint8_t>& wasm, const vector<char>& abi ) {
+      set_code( account, wasm );
+      set_abi( account, abi.data() );
+      set_code_permission( account );
+
+      const auto& accnt = control->db().get<account_object,by_name>( account );
+      abi_def abi_d;
+      BOOST_REQUIRE_EQUAL( abi_serializer::to_abi( accnt.abi, abi_d ), true );
+      abis[account].set_abi( abi_d, abi_serializer_max_time );
+   }
+
+   //let the contract send inline actions on behalf of itself
+   void set_code_permission( const name& account ) {
+      set_authority( account, config::active_name,
+                     authority( 1, { key_weight{ get_public_key( account, "active" ), 1 } },
+                                   { permission_level_weight{ { account, config::eosio_code_name }, 1 } } ),
+                     config::owner_name );
+   }
+
+   action_result push_action( const name& code, const name& signer, const name& act, const variant_object& data ) {
+      auto& abi_ser = abis.at( code );
+      string action_type_name = abi_ser.get_action_type( act );
+
+      action a;
+      a.account = code;
+      a.name    = act;
+      a.data    = abi_ser.variant_to_binary( action_type_name, data, abi_serializer_max_time );
+
+      return base_tester::push_action( std::move(a), signer.to_uint64_t() );
+   }
+
+   fc::variant get_row( const name& code, const uint64_t& scope, const name& table, const uint64_t& pk ) {
+      auto& abi_ser = abis.at( code );
+      vector<char> data = get_row_by_account( code, scope, table, name(pk) );
+      return data.empty() ? fc::variant() : abi_ser.binary_to_variant( abi_ser.get_table_type( table ), data, abi_serializer_max_time );
+   }
+
+   fc::variant get_singleton( const name& code, const name& table ) {
+      return get_row( code, code.to_uint64_t(), table, table.to_uint64_t() );
+   }
+
+   //rows of a table in primary key order
+   vector<fc::variant> get_rows( const name& code, const uint64_t& scope, const name& table ) {
+      vector<fc::variant> rows;
+      auto& abi_ser = abis.at( code );
+      const auto& db = control->db();
+      const auto* t_id = db.find<table_id_object, by_code_scope_table>( boost::make_tuple( code, name(scope), table ) );
+      if ( !t_id ) return rows;
+
+      const auto& idx = db.get_index<key_value_index, by_scope_primary>();
+      for (auto itr = idx.lower_bound( boost::make_tuple( t_id->id, 0 ) ); itr != idx.end() && itr->t_id == t_id->id; itr++) {
+         vector<char> data( itr->value.data(), itr->value.data() + itr->value.size() );
+         rows.push_back( abi_ser.binary_to_variant( abi_ser.get_table_type( table ), data, abi_serializer_max_time ) );
+      }
+      return rows;
+   }
+
+   //fungible token helpers, amax.token compatible
+   void create_currency( const name& contract, const name& issuer, const asset& max_supply ) {
+      BOOST_REQUIRE_EQUAL( success(), push_action( contract, contract, N(create), mvo()
+         ("issuer", issuer)
+         ("maximum_supply", max_supply)
+      ));
+   }
+
+   void issue( const name& contract, const name& issuer, const name& to, const asset& quantity ) {
+      BOOST_REQUIRE_EQUAL( success(), push_action( contract, issuer, N(issue), mvo()
+         ("to", issuer)
+         ("quantity", quantity)
+         ("memo", "")
+      ));
+      if (to != issuer)
+         BOOST_REQUIRE_EQUAL( success(), transfer( contract, issuer, to, quantity, "" ) );
+   }
+
+   action_result transfer( const name& contract, const name& from, const name& to, const asset& quantity, const string& memo ) {
+      return push_action( contract, from, N(transfer), mvo()
+         ("from", from)
+         ("to", to)
+         ("quantity", quantity)
+         ("memo", memo)
+      );
+   }
+
+   asset get_balance( const name& contract, const name& owner, const symbol& sym ) {
+      auto row = get_row( contract, owner.to_uint64_t(), N(accounts), sym.to_symbol_code().value );
+      return row.is_null() ? asset(0, sym) : row["balance"].as<asset>();
+   }
+
+   //non-fungible token helpers, amax.ntoken compatible
+   static fc::variant nasset( const int64_t& amount, const uint32_t& id, const uint32_t& parent_id = 0 ) {
+      return mvo()("amount", amount)("symbol", mvo()("id", id)("parent_id", parent_id));
+   }
+
+   void create_ntoken( const name& contract, const name& issuer, const int64_t& max_supply,
+                       const uint32_t& id, const uint32_t& parent_id = 0 ) {
+      BOOST_REQUIRE_EQUAL( success(), push_action( contract, issuer, N(create), mvo()
+         ("issuer", issuer)
+         ("maximum_supply", max_supply)
+         ("symbol", mvo()("id", id)("parent_id", parent_id))
+         ("token_uri", "https://nft/" + to_string(id))
+         ("ipowner", issuer)
+      ));
+   }
+
+   void issue_ntoken( const name& contract, const name& issuer, const name& to, const fc::variant& quantity ) {
+      BOOST_REQUIRE_EQUAL( success(), push_action( contract, issuer, N(issue), mvo()
+         ("to", issuer)
+         ("quantity", quantity)
+         ("memo", "")
+      ));
+      if (to != issuer)
+         BOOST_REQUIRE_EQUAL( success(), transfer_ntokens( contract, issuer, to, { quantity }, "" ) );
+   }
+
+   action_result transfer_ntokens( const name& contract, const name& from, const name& to,
+                                   const vector<fc::variant>& assets, const string& memo ) {
+      return push_action( contract, from, N(transfer), mvo()
+         ("from", from)
+         ("to", to)
+         ("assets", assets)
+         ("memo", memo)
+      );
+   }
+
+   int64_t get_ntoken_balance( const name& contract, const name& owner, const uint32_t& id, const uint32_t& parent_id = 0 ) {
+      auto row = get_row( contract, owner.to_uint64_t(), N(accounts), (uint64_t)parent_id << 32 | id );
+      return row.is_null() ? 0 : row["balance"]["amount"].as<int64_t>();
+   }
+
+   //seconds since epoch of the head block
+   uint32_t now() {
+      return control->head_block_time().sec_since_epoch();
+   }
+
+   uint32_t today() {
+      return now() / DAY_SECONDS;
+   }
+
+   void produce_days( const uint32_t& days ) {
+      produce_block( fc::seconds( days * DAY_SECONDS ) );
+      produce_blocks();
+   }
+
+   std::map<name, abi_serializer> abis;
+};
@@ -0,0 +1,398 @@
+#include "apollo_tester.hpp"
+
+class nftone_save_tester : public apollo_tester {
+public:
+   const name NFTONE_SAVE  = N(nftone.save);
+   const name SYS_BANK     = N(amax.token);
+   const name NFT_BANK     = N(amax.ntoken);
+   const name ADMIN        = N(nftone.admin);
+   const name SPONSOR      = N(sponsor);
+
+   nftone_save_tester() {
+      produce_blocks( 2 );
+
+      create_accounts( { SYS_BANK, NFT_BANK, NFTONE_SAVE, ADMIN, SPONSOR, N(alice), N(bob) } );
+      produce_blocks( 2 );
+
+      deploy_contract( SYS_BANK,    contracts::deps::token_wasm(),  contracts::deps::token_abi() );
+      deploy_contract( NFT_BANK,    contracts::deps::ntoken_wasm(), contracts::deps::ntoken_abi() );
+      deploy_contract( NFTONE_SAVE, contracts::nftone_save_wasm(),  contracts::nftone_save_abi() );
+      produce_blocks();
+
+      create_currency( SYS_BANK, SYS_BANK, asset::from_string("10000000000.00000000 AMAX") );
+      issue( SYS_BANK, SYS_BANK, SPONSOR, asset::from_string("100000.00000000 AMAX") );
+
+      for (uint32_t id = 1; id <= 3; id++) {
+         create_ntoken( NFT_BANK, NFT_BANK, 1000, id );
+         issue_ntoken( NFT_BANK, NFT_BANK, N(alice), nasset( 100, id ) );
+         issue_ntoken( NFT_BANK, NFT_BANK, N(bob), nasset( 100, id ) );
+      }
+
+      BOOST_REQUIRE_EQUAL( success(), push_action( NFTONE_SAVE, NFTONE_SAVE, N(init), mvo()
+         ("ntoken_contract", vector<name>{ NFT_BANK })
+         ("profit_token_contract", vector<name>{ SYS_BANK })
+         ("nft_size_limit", 5)
+         ("plan_size_limit", 5)
+      ));
+      produce_blocks();
+   }
+
+   //campaign over ntokens 1 and 2 with a single plan, open from now on
+   uint64_t create_campaign( const uint16_t& days, const asset& profit, const uint32_t& total_quotas,
+                             const uint32_t& end_in_days = 60 ) {
+      auto campaign_id = get_singleton( NFTONE_SAVE, N(global) ).is_null() ? 0 :
+                         get_singleton( NFTONE_SAVE, N(global) )["last_campaign_id"].as<uint64_t>();
+
+      BOOST_REQUIRE_EQUAL( success(), transfer( SYS_BANK, SPONSOR, NFTONE_SAVE, asset::from_string("1.00000000 AMAX"), "create_campaign" ) );
+      BOOST_REQUIRE_EQUAL( success(), transfer( SYS_BANK, SPONSOR, NFTONE_SAVE, asset::from_string("1000.00000000 AMAX"),
+                                                "refuelint:" + to_string(campaign_id) ) );
+      BOOST_REQUIRE_EQUAL( success(), push_action( NFTONE_SAVE, SPONSOR, N(setcampaign), mvo()
+         ("sponsor", SPONSOR)
+         ("campaign_id", campaign_id)
+         ("nftids", vector<uint64_t>{ 1, 2 })
+         ("plan_days_list", vector<uint16_t>{ days })
+         ("plan_profits_list", vector<asset>{ profit })
+         ("ntoken_contract", NFT_BANK)
+         ("total_quotas", total_quotas)
+         ("campaign_name_cn", "campaign")
+         ("campaign_name_en", "campaign")
+         ("campaign_pic_url", "https://pic")
+         ("begin_at", now())
+         ("end_at", now() + end_in_days * DAY_SECONDS)
+      ));
+      return campaign_id;
+   }
+
+   action_result setcampaign( const uint64_t& campaign_id, const vector<uint64_t>& nftids, const name& ntoken_contract ) {
+      return push_action( NFTONE_SAVE, SPONSOR, N(setcampaign), mvo()
+         ("sponsor", SPONSOR)
+         ("campaign_id", campaign_id)
+         ("nftids", nftids)
+         ("plan_days_list", vector<uint16_t>{ 10 })
+         ("plan_profits_list", vector<asset>{ asset::from_string("0.01000000 AMAX") })
+         ("ntoken_contract", ntoken_contract)
+         ("total_quotas", 100)
+         ("campaign_name_cn", "campaign")
+         ("campaign_name_en", "campaign")
+         ("campaign_pic_url", "https://pic")
+         ("begin_at", now())
+         ("end_at", now() + 60 * DAY_SECONDS)
+      );
+   }
+
+   action_result pledge( const name& from, const uint64_t& campaign_id, const uint16_t& days, const vector<fc::variant>& assets ) {
+      return transfer_ntokens( NFT_BANK, from, NFTONE_SAVE, assets, "pledge:" + to_string(campaign_id) + ":" + to_string(days) );
+   }
+
+   action_result gc( const uint64_t& cursor, const uint32_t& max_rows ) {
+      return push_action( NFTONE_SAVE, ADMIN, N(gc), mvo()("cursor", cursor)("max_rows", max_rows) );
+   }
+
+   action_result refundint( const uint64_t& campaign_id ) {
+      return push_action( NFTONE_SAVE, SPONSOR, N(refundint), mvo()("issuer", SPONSOR)("owner", SPONSOR)("campaign_id", campaign_id) );
+   }
+
+   action_result collectint( const name& owner, const uint64_t& save_id ) {
+      return push_action( NFTONE_SAVE, owner, N(collectint), mvo()("issuer", owner)("owner", owner)("save_id", save_id) );
+   }
+
+   action_result redeem( const name& owner, const uint64_t& save_id ) {
+      return push_action( NFTONE_SAVE, owner, N(redeem), mvo()("issuer", owner)("owner", owner)("save_id", save_id) );
+   }
+
+   action_result claimall( const name& owner, const uint64_t& cursor, const uint32_t& max_rows ) {
+      return push_action( NFTONE_SAVE, owner, N(claimall), mvo()("owner", owner)("cursor", cursor)("max_rows", max_rows) );
+   }
+
+   fc::variant get_campaign( const uint64_t& campaign_id ) {
+      return get_row( NFTONE_SAVE, NFTONE_SAVE.to_uint64_t(), N(campaigns), campaign_id );
+   }
+
+   fc::variant get_campaign_ntoken( const uint64_t& campaign_id, const uint32_t& id ) {
+      return get_row( NFTONE_SAVE, campaign_id, N(campntokens), id );
+   }
+
+   fc::variant get_save_acct( const name& owner, const uint64_t& save_id ) {
+      return get_row( NFTONE_SAVE, owner.to_uint64_t(), N(saveaccounts), save_id );
+   }
+
+   fc::variant get_claim_cursor( const name& owner ) {
+      return get_row( NFTONE_SAVE, owner.to_uint64_t(), N(claimcursor), N(claimcursor).to_uint64_t() );
+   }
+
+   asset get_amax_balance( const name& owner ) {
+      return get_balance( SYS_BANK, owner, symbol(8, "AMAX") );
+   }
+};
+
+BOOST_AUTO_TEST_SUITE(nftone_save_tests)
+
+BOOST_FIXTURE_TEST_CASE( pledge_every_nasset_of_a_transfer, nftone_save_tester ) try {
+   auto campaign_id = create_campaign( 10, asset::from_string("0.01000000 AMAX"), 100 );
+   produce_blocks();
+
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(alice), campaign_id, 10, { nasset( 1, 1 ), nasset( 2, 2 ) } ) );
+   produce_blocks();
+
+   auto acct = get_save_acct( N(alice), 0 );
+   BOOST_REQUIRE( !acct.is_null() );
+   BOOST_REQUIRE_EQUAL( 1, acct["pledged"]["quantity"]["amount"].as<int64_t>() );
+   BOOST_REQUIRE_EQUAL( 1u, acct["pledged"]["quantity"]["symbol"]["id"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( asset::from_string("0.10000000 AMAX"), acct["interest_alloted"].as<asset>() );
+
+   acct = get_save_acct( N(alice), 1 );
+   BOOST_REQUIRE( !acct.is_null() );
+   BOOST_REQUIRE_EQUAL( 2, acct["pledged"]["quantity"]["amount"].as<int64_t>() );
+   BOOST_REQUIRE_EQUAL( 2u, acct["pledged"]["quantity"]["symbol"]["id"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( asset::from_string("0.20000000 AMAX"), acct["interest_alloted"].as<asset>() );
+
+   auto campaign = get_campaign( campaign_id );
+   BOOST_REQUIRE_EQUAL( 3u, campaign["quotas_purchased"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( asset::from_string("0.30000000 AMAX"), campaign["interest_alloted"].as<asset>() );
+   BOOST_REQUIRE_EQUAL( 1u, get_campaign_ntoken( campaign_id, 1 )["allocated_quotas"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( 2u, get_campaign_ntoken( campaign_id, 2 )["allocated_quotas"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( 97, get_ntoken_balance( NFT_BANK, N(alice), 1 ) + get_ntoken_balance( NFT_BANK, N(alice), 2 ) );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( pledge_rejects_the_whole_transfer, nftone_save_tester ) try {
+   auto campaign_id = create_campaign( 10, asset::from_string("0.01000000 AMAX"), 4 );
+   produce_blocks();
+
+   //ntoken 3 is not part of the campaign
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("[[10101]] this ntoken does not exist"),
+                        pledge( N(alice), campaign_id, 10, { nasset( 1, 1 ), nasset( 1, 3 ) } ) );
+   //quotas are checked per nasset against what is left
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("[[1]] quotas insufficient"),
+                        pledge( N(alice), campaign_id, 10, { nasset( 3, 1 ), nasset( 2, 2 ) } ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("[[10101]] this plan does not exist"),
+                        pledge( N(alice), campaign_id, 20, { nasset( 1, 1 ) } ) );
+
+   BOOST_REQUIRE( get_save_acct( N(alice), 0 ).is_null() );
+   BOOST_REQUIRE_EQUAL( 0u, get_campaign( campaign_id )["quotas_purchased"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( 100, get_ntoken_balance( NFT_BANK, N(alice), 1 ) );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( campaign_children_and_meta_rows, nftone_save_tester ) try {
+   auto campaign_id = create_campaign( 10, asset::from_string("0.01000000 AMAX"), 100 );
+   produce_blocks();
+
+   auto campaign = get_campaign( campaign_id );
+   BOOST_REQUIRE_EQUAL( name("created"), campaign["status"].as<name>() );
+   BOOST_REQUIRE_EQUAL( 2u, campaign["ntoken_count"].as<uint8_t>() );
+   BOOST_REQUIRE_EQUAL( 1u, campaign["plan_count"].as<uint8_t>() );
+   BOOST_REQUIRE_EQUAL( 2u, get_rows( NFTONE_SAVE, campaign_id, N(campntokens) ).size() );
+   BOOST_REQUIRE_EQUAL( asset::from_string("0.01000000 AMAX"),
+                        get_row( NFTONE_SAVE, campaign_id, N(campplans), 10 )["profit"].as<asset>() );
+
+   auto meta = get_row( NFTONE_SAVE, NFTONE_SAVE.to_uint64_t(), N(campmeta), campaign_id );
+   BOOST_REQUIRE_EQUAL( "campaign", meta["campaign_name_cn"].as<string>() );
+   BOOST_REQUIRE_EQUAL( "https://pic", meta["campaign_pic_url"].as<string>() );
+   BOOST_REQUIRE( get_rows( NFTONE_SAVE, NFTONE_SAVE.to_uint64_t(), N(savecampaign) ).empty() );
+
+   //existing ntokens and plans are kept, new ones appended
+   BOOST_REQUIRE_EQUAL( success(), push_action( NFTONE_SAVE, SPONSOR, N(setcampaign), mvo()
+      ("sponsor", SPONSOR)
+      ("campaign_id", campaign_id)
+      ("nftids", vector<uint64_t>{ 2, 3 })
+      ("plan_days_list", vector<uint16_t>{ 10, 20 })
+      ("plan_profits_list", vector<asset>{ asset::from_string("0.02000000 AMAX"), asset::from_string("0.01000000 AMAX") })
+      ("ntoken_contract", NFT_BANK)
+      ("total_quotas", 100)
+      ("campaign_name_cn", "campaign 2")
+      ("campaign_name_en", "")
+      ("campaign_pic_url", "https://pic2")
+      ("begin_at", now())
+      ("end_at", now() + 90 * DAY_SECONDS)
+   ));
+   campaign = get_campaign( campaign_id );
+   BOOST_REQUIRE_EQUAL( 3u, campaign["ntoken_count"].as<uint8_t>() );
+   BOOST_REQUIRE_EQUAL( 2u, campaign["plan_count"].as<uint8_t>() );
+   BOOST_REQUIRE_EQUAL( 3u, get_rows( NFTONE_SAVE, campaign_id, N(campntokens) ).size() );
+   BOOST_REQUIRE_EQUAL( asset::from_string("0.01000000 AMAX"),
+                        get_row( NFTONE_SAVE, campaign_id, N(campplans), 10 )["profit"].as<asset>() );
+   BOOST_REQUIRE_EQUAL( "campaign 2",
+                        get_row( NFTONE_SAVE, NFTONE_SAVE.to_uint64_t(), N(campmeta), campaign_id )["campaign_name_cn"].as<string>() );
+
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(alice), campaign_id, 20, { nasset( 1, 3 ) } ) );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( migratecamp_without_legacy_campaign, nftone_save_tester ) try {
+   auto campaign_id = create_campaign( 10, asset::from_string("0.01000000 AMAX"), 100 );
+   produce_blocks();
+
+   BOOST_REQUIRE_EQUAL( error("missing authority of nftone.admin"),
+      push_action( NFTONE_SAVE, SPONSOR, N(migratecamp), mvo()("campaign_ids", vector<uint64_t>{ campaign_id }) ) );
+   BOOST_REQUIRE_EQUAL( success(),
+      push_action( NFTONE_SAVE, ADMIN, N(migratecamp), mvo()("campaign_ids", vector<uint64_t>{ campaign_id, 9 }) ) );
+   BOOST_REQUIRE_EQUAL( 2u, get_campaign( campaign_id )["ntoken_count"].as<uint8_t>() );
+   BOOST_REQUIRE( get_campaign( 9 ).is_null() );
+
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("[[10009]] campaign not found: 9"),
+      push_action( NFTONE_SAVE, SPONSOR, N(setcamptime), mvo()
+         ("sponsor", SPONSOR)("campaign_id", 9)("begin_at", now())("end_at", now() + DAY_SECONDS) ) );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( setcampaign_rejects_nft_id_from_another_contract, nftone_save_tester ) try {
+   const name NFT_BANK2 = N(nft.bank2);
+   create_accounts( { NFT_BANK2 } );
+   deploy_contract( NFT_BANK2, contracts::deps::ntoken_wasm(), contracts::deps::ntoken_abi() );
+   create_ntoken( NFT_BANK2, NFT_BANK2, 1000, 1 );
+   BOOST_REQUIRE_EQUAL( success(), push_action( NFTONE_SAVE, NFTONE_SAVE, N(init), mvo()
+      ("ntoken_contract", vector<name>{ NFT_BANK, NFT_BANK2 })
+      ("profit_token_contract", vector<name>{ SYS_BANK })
+      ("nft_size_limit", 5)
+      ("plan_size_limit", 5)
+   ));
+   auto campaign_id = create_campaign( 10, asset::from_string("0.01000000 AMAX"), 100 );
+   produce_blocks();
+
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("[[10101]] nft id already pledged from another contract: 1"),
+                        setcampaign( campaign_id, { 1 }, NFT_BANK2 ) );
+   BOOST_REQUIRE_EQUAL( 2u, get_campaign( campaign_id )["ntoken_count"].as<uint8_t>() );
+   BOOST_REQUIRE_EQUAL( NFT_BANK, get_campaign_ntoken( campaign_id, 1 )["symbol"]["contract"].as<name>() );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( migratecamp_keeps_first_listing_of_colliding_id, nftone_save_tester ) try {
+   const name NFT_BANK2 = N(nft.bank2);
+   create_accounts( { NFT_BANK2 } );
+   deploy_contract( NFT_BANK2, contracts::deps::ntoken_wasm(), contracts::deps::ntoken_abi() );
+   create_ntoken( NFT_BANK2, NFT_BANK2, 1000, 1 );
+   issue_ntoken( NFT_BANK2, NFT_BANK2, N(alice), nasset( 100, 1 ) );
+   produce_blocks();
+
+   //the legacy release lists nft id 1 from both contracts in one campaign
+   deploy_contract( NFTONE_SAVE, contracts::deps::nftone_save_v1_wasm(), contracts::deps::nftone_save_v1_abi() );
+   BOOST_REQUIRE_EQUAL( success(), push_action( NFTONE_SAVE, NFTONE_SAVE, N(init), mvo()
+      ("ntoken_contract", vector<name>{ NFT_BANK, NFT_BANK2 })
+      ("profit_token_contract", vector<name>{ SYS_BANK })
+      ("nft_size_limit", 5)
+      ("plan_size_limit", 5)
+   ));
+   auto campaign_id = create_campaign( 10, asset::from_string("0.01000000 AMAX"), 100 );
+   BOOST_REQUIRE_EQUAL( success(), setcampaign( campaign_id, { 1 }, NFT_BANK2 ) );
+   BOOST_REQUIRE_EQUAL( 3u, get_row( NFTONE_SAVE, NFTONE_SAVE.to_uint64_t(), N(savecampaign), campaign_id )["pledge_ntokens"]
+                            .get_array().size() );
+   produce_blocks();
+
+   deploy_contract( NFTONE_SAVE, contracts::nftone_save_wasm(), contracts::nftone_save_abi() );
+   produce_blocks();
+   BOOST_REQUIRE_EQUAL( success(),
+      push_action( NFTONE_SAVE, ADMIN, N(migratecamp), mvo()("campaign_ids", vector<uint64_t>{ campaign_id }) ) );
+   BOOST_REQUIRE( get_rows( NFTONE_SAVE, NFTONE_SAVE.to_uint64_t(), N(savecampaign) ).empty() );
+   BOOST_REQUIRE_EQUAL( 2u, get_campaign( campaign_id )["ntoken_count"].as<uint8_t>() );
+   BOOST_REQUIRE_EQUAL( 2u, get_rows( NFTONE_SAVE, campaign_id, N(campntokens) ).size() );
+
+   //the campaign stays usable through the kept listing only
+   auto kept    = get_campaign_ntoken( campaign_id, 1 )["symbol"]["contract"].as<name>();
+   auto dropped = kept == NFT_BANK ? NFT_BANK2 : NFT_BANK;
+   BOOST_REQUIRE_EQUAL( success(), transfer_ntokens( kept, N(alice), NFTONE_SAVE, { nasset( 1, 1 ) }, "pledge:" + to_string(campaign_id) + ":10" ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("[[10101]] this ntoken does not exist"),
+                        transfer_ntokens( dropped, N(alice), NFTONE_SAVE, { nasset( 1, 1 ) }, "pledge:" + to_string(campaign_id) + ":10" ) );
+   BOOST_REQUIRE_EQUAL( 1u, get_campaign( campaign_id )["quotas_purchased"].as<uint32_t>() );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( gc_deletes_refunded_and_redeemed_campaigns, nftone_save_tester ) try {
+   auto idle_id = create_campaign( 10, asset::from_string("0.01000000 AMAX"), 100, 1 );
+   produce_blocks();
+   auto busy_id = create_campaign( 10, asset::from_string("0.01000000 AMAX"), 100, 1 );
+   produce_blocks();
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(alice), busy_id, 10, { nasset( 1, 1 ) } ) );
+
+   BOOST_REQUIRE_EQUAL( error("missing authority of nftone.admin"),
+      push_action( NFTONE_SAVE, SPONSOR, N(gc), mvo()("cursor", 0)("max_rows", 10) ) );
+
+   //nothing refunded yet
+   BOOST_REQUIRE_EQUAL( success(), gc( 0, 10 ) );
+   BOOST_REQUIRE( !get_campaign( idle_id ).is_null() );
+
+   produce_days( 2 );
+   BOOST_REQUIRE_EQUAL( success(), refundint( idle_id ) );
+   BOOST_REQUIRE_EQUAL( success(), refundint( busy_id ) );
+   produce_blocks();
+
+   //one campaign per action, the cursor is the next campaign id + 1
+   BOOST_REQUIRE_EQUAL( success(), gc( 0, 1 ) );
+   BOOST_REQUIRE( get_campaign( idle_id ).is_null() );
+   BOOST_REQUIRE( get_rows( NFTONE_SAVE, idle_id, N(campntokens) ).empty() );
+   BOOST_REQUIRE( get_rows( NFTONE_SAVE, idle_id, N(campplans) ).empty() );
+   BOOST_REQUIRE( get_row( NFTONE_SAVE, NFTONE_SAVE.to_uint64_t(), N(campmeta), idle_id ).is_null() );
+   auto cursor = get_singleton( NFTONE_SAVE, N(gccursor) );
+   BOOST_REQUIRE_EQUAL( busy_id + 1, cursor["next_cursor"].as<uint64_t>() );
+   BOOST_REQUIRE_EQUAL( 1u, cursor["deleted_count"].as<uint32_t>() );
+
+   //alice's position is still open
+   BOOST_REQUIRE_EQUAL( success(), gc( busy_id + 1, 10 ) );
+   BOOST_REQUIRE( !get_campaign( busy_id ).is_null() );
+   cursor = get_singleton( NFTONE_SAVE, N(gccursor) );
+   BOOST_REQUIRE_EQUAL( 0u, cursor["next_cursor"].as<uint64_t>() );
+   BOOST_REQUIRE_EQUAL( 0u, cursor["deleted_count"].as<uint32_t>() );
+
+   produce_days( 10 );
+   BOOST_REQUIRE_EQUAL( success(), collectint( N(alice), 0 ) );
+   BOOST_REQUIRE_EQUAL( success(), redeem( N(alice), 0 ) );
+   produce_blocks();
+
+   BOOST_REQUIRE_EQUAL( success(), gc( 0, 10 ) );
+   BOOST_REQUIRE( get_campaign( busy_id ).is_null() );
+   BOOST_REQUIRE( get_rows( NFTONE_SAVE, busy_id, N(campntokens) ).empty() );
+   BOOST_REQUIRE_EQUAL( 1u, get_singleton( NFTONE_SAVE, N(gccursor) )["deleted_count"].as<uint32_t>() );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( claimall_collects_then_redeems, nftone_save_tester ) try {
+   auto campaign_id = create_campaign( 10, asset::from_string("0.01000000 AMAX"), 100 );
+   produce_blocks();
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(alice), campaign_id, 10, { nasset( 1, 1 ), nasset( 2, 2 ) } ) );
+   produce_days( 3 );
+
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("[[10101]] max_rows must be greater than 0"), claimall( N(alice), 0, 0 ) );
+   BOOST_REQUIRE_EQUAL( error("missing authority of alice"),
+      push_action( NFTONE_SAVE, N(bob), N(claimall), mvo()("owner", N(alice))("cursor", 0)("max_rows", 10) ) );
+
+   //resume from save id 1
+   BOOST_REQUIRE_EQUAL( success(), claimall( N(alice), 1, 10 ) );
+   BOOST_REQUIRE_EQUAL( 0, get_save_acct( N(alice), 0 )["interest_collected"].as<asset>().get_amount() );
+   auto collected = get_save_acct( N(alice), 1 )["interest_collected"].as<asset>();
+   BOOST_REQUIRE( collected.get_amount() > 0 );
+   BOOST_REQUIRE_EQUAL( collected, get_amax_balance( N(alice) ) );
+   BOOST_REQUIRE_EQUAL( 0u, get_claim_cursor( N(alice) )["next_cursor"].as<uint64_t>() );
+   produce_blocks();
+
+   //one position with interest due per row
+   BOOST_REQUIRE_EQUAL( success(), claimall( N(alice), 0, 1 ) );
+   BOOST_REQUIRE( get_save_acct( N(alice), 0 )["interest_collected"].as<asset>().get_amount() > 0 );
+   BOOST_REQUIRE_EQUAL( collected, get_save_acct( N(alice), 1 )["interest_collected"].as<asset>() );
+   BOOST_REQUIRE_EQUAL( 1u, get_claim_cursor( N(alice) )["next_cursor"].as<uint64_t>() );
+
+   //matured positions are collected in full and redeemed
+   produce_days( 10 );
+   BOOST_REQUIRE_EQUAL( success(), claimall( N(alice), 0, 10 ) );
+   BOOST_REQUIRE( get_rows( NFTONE_SAVE, N(alice).to_uint64_t(), N(saveaccounts) ).empty() );
+   BOOST_REQUIRE_EQUAL( asset::from_string("0.30000000 AMAX"), get_amax_balance( N(alice) ) );
+   BOOST_REQUIRE_EQUAL( 100, get_ntoken_balance( NFT_BANK, N(alice), 1 ) );
+   BOOST_REQUIRE_EQUAL( 100, get_ntoken_balance( NFT_BANK, N(alice), 2 ) );
+   BOOST_REQUIRE_EQUAL( 1u, get_campaign_ntoken( campaign_id, 1 )["redeemed_quotas"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( 2u, get_campaign_ntoken( campaign_id, 2 )["redeemed_quotas"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( asset::from_string("0.30000000 AMAX"), get_campaign( campaign_id )["interest_collected"].as<asset>() );
+
+   //nothing left to claim
+   BOOST_REQUIRE_EQUAL( success(), claimall( N(alice), 0, 10 ) );
+   BOOST_REQUIRE_EQUAL( 0u, get_claim_cursor( N(alice) )["next_cursor"].as<uint64_t>() );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( claimall_counts_rows_with_nothing_due, nftone_save_tester ) try {
+   auto campaign_id = create_campaign( 10, asset::from_string("0.01000000 AMAX"), 100 );
+   produce_blocks();
+
+   //claimed in the pledge block, no interest has accrued yet
+   BOOST_REQUIRE_EQUAL( success(), pledge( N(alice), campaign_id, 10, { nasset( 1, 1 ), nasset( 2, 2 ) } ) );
+   BOOST_REQUIRE_EQUAL( success(), claimall( N(alice), 0, 1 ) );
+   BOOST_REQUIRE_EQUAL( 1u, get_claim_cursor( N(alice) )["next_cursor"].as<uint64_t>() );
+   BOOST_REQUIRE_EQUAL( asset::from_string("0.00000000 AMAX"), get_amax_balance( N(alice) ) );
+   BOOST_REQUIRE_EQUAL( 2u, get_rows( NFTONE_SAVE, N(alice).to_uint64_t(), N(saveaccounts) ).size() );
+
+   BOOST_REQUIRE_EQUAL( success(), claimall( N(alice), 1, 1 ) );
+   BOOST_REQUIRE_EQUAL( 0u, get_claim_cursor( N(alice) )["next_cursor"].as<uint64_t>() );
+   BOOST_REQUIRE_EQUAL( 2u, get_rows( NFTONE_SAVE, N(alice).to_uint64_t(), N(saveaccounts) ).size() );
+} FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_SUITE_END()